@@ -0,0 +1,259 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "animation.hpp"
+#include <algorithm>
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// A start time for steps that have not begun.
+/// </summary>
+static const double Never = 1e30;
+
+/// <summary>
+/// Constructor.
+/// </summary>
+TableAnimation::TableAnimation() : round(0), queueEnd(0.0), ticks(0)
+{
+	Reset();
+}
+
+/// <summary>
+/// Forgets the round shown, for a new one.
+/// </summary>
+void TableAnimation::Reset()
+{
+	timeline.Clear();
+	queueEnd = timeline.GetTime();
+	std::fill(std::begin(dealerStart), std::end(dealerStart), Never);
+	dealerCount = 0;
+	for (int h = 0; h < Player::MaxHands; h++)
+	{
+		std::fill(std::begin(handStart[h]), std::end(handStart[h]), Never);
+		cardCounts[h] = 0;
+	}
+	handCount = 0;
+	revealed = false;
+	revealStart = Never;
+	paid = false;
+	chipStart = Never;
+	chipDirection = 0;
+}
+
+/// <summary>
+/// Books the next span of time after every step already booked.
+/// </summary>
+/// <param name="length">The step's length, in seconds.</param>
+/// <returns>When the step starts.</returns>
+double TableAnimation::Reserve(double length)
+{
+	double start = std::max(queueEnd, timeline.GetTime());
+	queueEnd = start + length;
+	return start;
+}
+
+/// <summary>
+/// Flies a card in.
+/// </summary>
+/// <param name="start">Set to when the card leaves the shoe.</param>
+Timeline::Task TableAnimation::Deal(double& start)
+{
+	double at = Reserve(DealInterval);
+	co_await timeline.At(at);
+	start = at;
+	co_await timeline.After(DealTime);
+	ticks++;
+}
+
+/// <summary>
+/// Turns the hole card over.
+/// </summary>
+Timeline::Task TableAnimation::Reveal()
+{
+	double at = Reserve(FlipTime);
+	co_await timeline.At(at);
+	revealStart = at;
+	co_await timeline.After(FlipTime);
+}
+
+/// <summary>
+/// Sends the bet's chip to whoever won it.
+/// </summary>
+/// <param name="direction">1 for the player, -1 for the dealer.</param>
+Timeline::Task TableAnimation::Pay(int direction)
+{
+	double at = Reserve(ChipTime);
+	co_await timeline.At(at);
+	chipStart = at;
+	chipDirection = direction;
+	co_await timeline.After(ChipTime);
+	ticks++;
+}
+
+/// <summary>
+/// Moves the animations on, once a frame.
+/// </summary>
+/// <param name="now">The time, in seconds.</param>
+void TableAnimation::Advance(double now)
+{
+	timeline.Advance(now);
+}
+
+/// <summary>
+/// Books steps for everything that changed since the last snapshot.
+/// </summary>
+/// <param name="table">The newest snapshot.</param>
+void TableAnimation::Observe(const TableSnapshot& table)
+{
+	if (table.round != round)
+	{
+		Reset();
+		round = table.round;
+	}
+
+	// Steps are booked in the order the cards reach the table: the dealer's first two, the player's, the hole card, the dealer's draws.
+	for (; dealerCount < std::min(table.dealerCount, 2); dealerCount++)
+	{
+		dealer[dealerCount] = table.dealer[dealerCount];
+		Deal(dealerStart[dealerCount]);
+	}
+
+	// A split moves a card to the new hand, it is already on the table so it does not fly.
+	Card before[Player::MaxHands * Hand::MaxCards];
+	int beforeCount = 0;
+	for (int h = 0; h < handCount; h++)
+	{
+		beforeCount = (int)(std::copy(hands[h], hands[h] + cardCounts[h], before + beforeCount) - before);
+	}
+	for (int h = 0; h < table.handCount; h++)
+	{
+		for (int i = 0; i < table.cardCounts[h]; i++)
+		{
+			Card card = table.hands[h][i];
+			if (h < handCount && i < cardCounts[h] && hands[h][i].code == card.code)
+			{
+				continue;
+			}
+			hands[h][i] = card;
+			if (std::any_of(before, before + beforeCount, [&](Card seen) { return seen.code == card.code; }))
+			{
+				handStart[h][i] = -Never;
+			}
+			else
+			{
+				Deal(handStart[h][i]);
+			}
+		}
+		cardCounts[h] = table.cardCounts[h];
+	}
+	handCount = table.handCount;
+
+	if (table.dealerRevealed && !revealed && dealerCount >= 2)
+	{
+		revealed = true;
+		Reveal();
+	}
+	for (; dealerCount < table.dealerCount; dealerCount++)
+	{
+		dealer[dealerCount] = table.dealer[dealerCount];
+		Deal(dealerStart[dealerCount]);
+	}
+
+	if (!paid && (table.state == GameState::Win || table.state == GameState::Lose))
+	{
+		paid = true;
+		Pay(table.state == GameState::Win ? 1 : -1);
+	}
+}
+
+/// <summary>
+/// Gets how far one of the dealer's cards has flown.
+/// </summary>
+/// <param name="card">The card's index.</param>
+/// <returns>From 0 at the shoe to 1 in place, negative while it has not been dealt.</returns>
+float TableAnimation::GetDealer(int card) const
+{
+	double start = dealerStart[card];
+	return start > timeline.GetTime() ? -1.0f : Tween{ start, DealTime, 0.0f, 1.0f }.GetProgress(timeline.GetTime());
+}
+
+/// <summary>
+/// Gets how far one of the player's cards has flown.
+/// </summary>
+/// <param name="hand">The hand.</param>
+/// <param name="card">The card's index.</param>
+/// <returns>From 0 at the shoe to 1 in place, negative while it has not been dealt.</returns>
+float TableAnimation::GetHand(int hand, int card) const
+{
+	double start = handStart[hand][card];
+	return start > timeline.GetTime() ? -1.0f : Tween{ start, DealTime, 0.0f, 1.0f }.GetProgress(timeline.GetTime());
+}
+
+/// <summary>
+/// Gets how far the hole card has turned.
+/// </summary>
+/// <returns>From 0 face down to 1 face up.</returns>
+float TableAnimation::GetReveal() const
+{
+	return Tween{ revealStart, FlipTime, 0.0f, 1.0f }.GetProgress(timeline.GetTime());
+}
+
+/// <summary>
+/// Gets how far the chip has moved.
+/// </summary>
+/// <param name="direction">Receives 1 if it is going to the player, -1 if to the dealer.</param>
+/// <returns>From 0 at the bet to 1 at the winner, negative if no chip is moving.</returns>
+float TableAnimation::GetChip(int& direction) const
+{
+	direction = chipDirection;
+	double now = timeline.GetTime();
+	if (chipStart > now || now >= chipStart + ChipTime)
+	{
+		return -1.0f;
+	}
+	return Tween{ chipStart, ChipTime, 0.0f, 1.0f }.GetProgress(now);
+}
+
+/// <summary>
+/// Checks if anything is still to happen.
+/// </summary>
+/// <returns>True while a step is waiting.</returns>
+bool TableAnimation::IsBusy() const
+{
+	return !timeline.IsIdle();
+}
+
+/// <summary>
+/// Checks if a card or chip has landed since the last call.
+/// </summary>
+/// <returns>True if something landed.</returns>
+bool TableAnimation::TakeTick()
+{
+	bool landed = ticks > 0;
+	ticks = 0;
+	return landed;
+}
@@ -0,0 +1,196 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "logic.hpp"
+#include "timeline.hpp"
+
+// The table's animations, worked out from the snapshots the logic thread publishes
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// Deals, flips and pays out whatever changed between snapshots, one step after another.
+		/// <para>Each step is a coroutine on a <see cref="Timeline"/>, the game has moved on already and never waits for them.</para>
+		/// </summary>
+		class TableAnimation
+		{
+		public:
+			/// <summary>
+			/// How long a card flies, and the time between cards, in seconds.
+			/// </summary>
+			static constexpr double DealTime = 0.2;
+			static constexpr double DealInterval = 0.25;
+
+			/// <summary>
+			/// How long the hole card takes to turn over, in seconds.
+			/// </summary>
+			static constexpr double FlipTime = 0.2;
+
+			/// <summary>
+			/// How long the chip takes to reach the winner, in seconds.
+			/// </summary>
+			static constexpr double ChipTime = 0.4;
+		private:
+			/// <summary>
+			/// Runs the steps.
+			/// </summary>
+			Timeline timeline;
+
+			/// <summary>
+			/// The round being shown, from <see cref="TableSnapshot::round"/>.
+			/// </summary>
+			uint32_t round;
+
+			/// <summary>
+			/// When the last step booked ends, the next starts no earlier.
+			/// </summary>
+			double queueEnd;
+
+			/// <summary>
+			/// The dealer's cards seen so far and when each began to fly, far in the future until then.
+			/// </summary>
+			Card dealer[Hand::MaxCards];
+			double dealerStart[Hand::MaxCards];
+			int dealerCount;
+
+			/// <summary>
+			/// The player's cards seen so far and when each began to fly.
+			/// </summary>
+			Card hands[Player::MaxHands][Hand::MaxCards];
+			double handStart[Player::MaxHands][Hand::MaxCards];
+			int cardCounts[Player::MaxHands];
+			int handCount;
+
+			/// <summary>
+			/// Whether the hole card has been turned, and when it began to turn.
+			/// </summary>
+			bool revealed;
+			double revealStart;
+
+			/// <summary>
+			/// Whether the round's chip has been sent, when it began to move and where to, 1 for the player and -1 for the dealer.
+			/// </summary>
+			bool paid;
+			double chipStart;
+			int chipDirection;
+
+			/// <summary>
+			/// Cards and chips landed since <see cref="TableAnimation::TakeTick"/> was last called.
+			/// </summary>
+			int ticks;
+
+			/// <summary>
+			/// Books the next span of time after every step already booked.
+			/// </summary>
+			/// <param name="length">The step's length, in seconds.</param>
+			/// <returns>When the step starts.</returns>
+			double Reserve(double length);
+
+			/// <summary>
+			/// Flies a card in.
+			/// </summary>
+			/// <param name="start">Set to when the card leaves the shoe.</param>
+			Timeline::Task Deal(double& start);
+
+			/// <summary>
+			/// Turns the hole card over.
+			/// </summary>
+			Timeline::Task Reveal();
+
+			/// <summary>
+			/// Sends the bet's chip to whoever won it.
+			/// </summary>
+			/// <param name="direction">1 for the player, -1 for the dealer.</param>
+			Timeline::Task Pay(int direction);
+
+			/// <summary>
+			/// Forgets the round shown, for a new one.
+			/// </summary>
+			void Reset();
+		public:
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			TableAnimation();
+
+			/// <summary>
+			/// Moves the animations on, once a frame.
+			/// </summary>
+			/// <param name="now">The time, in seconds.</param>
+			void Advance(double now);
+
+			/// <summary>
+			/// Books steps for everything that changed since the last snapshot.
+			/// </summary>
+			/// <param name="table">The newest snapshot.</param>
+			void Observe(const TableSnapshot& table);
+
+			/// <summary>
+			/// Gets how far one of the dealer's cards has flown.
+			/// </summary>
+			/// <param name="card">The card's index.</param>
+			/// <returns>From 0 at the shoe to 1 in place, negative while it has not been dealt.</returns>
+			float GetDealer(int card) const;
+
+			/// <summary>
+			/// Gets how far one of the player's cards has flown.
+			/// </summary>
+			/// <param name="hand">The hand.</param>
+			/// <param name="card">The card's index.</param>
+			/// <returns>From 0 at the shoe to 1 in place, negative while it has not been dealt.</returns>
+			float GetHand(int hand, int card) const;
+
+			/// <summary>
+			/// Gets how far the hole card has turned.
+			/// </summary>
+			/// <returns>From 0 face down to 1 face up.</returns>
+			float GetReveal() const;
+
+			/// <summary>
+			/// Gets how far the chip has moved.
+			/// </summary>
+			/// <param name="direction">Receives 1 if it is going to the player, -1 if to the dealer.</param>
+			/// <returns>From 0 at the bet to 1 at the winner, negative if no chip is moving.</returns>
+			float GetChip(int& direction) const;
+
+			/// <summary>
+			/// Checks if anything is still to happen.
+			/// </summary>
+			/// <returns>True while a step is waiting.</returns>
+			bool IsBusy() const;
+
+			/// <summary>
+			/// Checks if a card or chip has landed since the last call.
+			/// </summary>
+			/// <returns>True if something landed.</returns>
+			bool TakeTick();
+		};
+	}
+}
@@ -0,0 +1,181 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "atlas.hpp"
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Draws a suit symbol with shapes, the default font has no suit glyphs.
+/// </summary>
+/// <param name="suit">The suit.</param>
+/// <param name="x">The symbol's center.</param>
+/// <param name="y">The symbol's center.</param>
+/// <param name="size">Half the symbol's width.</param>
+/// <param name="color">The color.</param>
+void CardAtlas::DrawSuit(CardSuit suit, float x, float y, float size, Color color)
+{
+	// Triangles are wound counter-clockwise or raylib culls them.
+	float r = size * 0.5f;
+	switch (suit)
+	{
+	case CLUBS:
+		DrawCircle((int)x, (int)(y - r), r, color);
+		DrawCircle((int)(x - r), (int)(y + r * 0.5f), r, color);
+		DrawCircle((int)(x + r), (int)(y + r * 0.5f), r, color);
+		DrawTriangle({ x, y }, { x - r, y + r * 2.0f }, { x + r, y + r * 2.0f }, color);
+		break;
+	case DIAMONDS:
+		DrawTriangle({ x, y - size * 1.2f }, { x - size, y }, { x, y + size * 1.2f }, color);
+		DrawTriangle({ x, y - size * 1.2f }, { x, y + size * 1.2f }, { x + size, y }, color);
+		break;
+	case HEARTS:
+		DrawCircle((int)(x - r), (int)(y - r * 0.6f), r, color);
+		DrawCircle((int)(x + r), (int)(y - r * 0.6f), r, color);
+		DrawTriangle({ x - size, y - r * 0.6f }, { x, y + size * 1.1f }, { x + size, y - r * 0.6f }, color);
+		break;
+	case SPADES:
+		DrawCircle((int)(x - r), (int)(y + r * 0.3f), r, color);
+		DrawCircle((int)(x + r), (int)(y + r * 0.3f), r, color);
+		DrawTriangle({ x, y - size * 1.2f }, { x - size, y + r * 0.3f }, { x + size, y + r * 0.3f }, color);
+		DrawTriangle({ x, y + r * 0.3f }, { x - r, y + r * 2.2f }, { x + r, y + r * 2.2f }, color);
+		break;
+	}
+}
+
+/// <summary>
+/// Gets the cell holding a card in the texture.
+/// </summary>
+/// <param name="column">The cell's column.</param>
+/// <param name="row">The cell's row.</param>
+/// <returns>The source rectangle, flipped because render textures are stored upside down.</returns>
+Rectangle CardAtlas::GetSource(int column, int row) const
+{
+	return { (float)(column * CellWidth), (float)(target.texture.height - (row + 1) * CellHeight), (float)CellWidth, (float)-CellHeight };
+}
+
+/// <summary>
+/// Draws a cell, squeezed about its middle.
+/// </summary>
+/// <param name="column">The cell's column.</param>
+/// <param name="row">The cell's row.</param>
+/// <param name="x">The card's left edge.</param>
+/// <param name="y">The card's top edge.</param>
+/// <param name="width">How much of the card's width to draw.</param>
+void CardAtlas::DrawCell(int column, int row, float x, float y, float width) const
+{
+	// Unsqueezed cells are copied as they are, which is every card but one turning over.
+	if (width >= 1.0f)
+	{
+		DrawTextureRec(target.texture, GetSource(column, row), { x, y }, WHITE);
+		return;
+	}
+	float squeezed = CellWidth * width;
+	Rectangle destination = { x + (CardWidth - CardWidth * width) / 2.0f, y, squeezed, (float)CellHeight };
+	DrawTexturePro(target.texture, GetSource(column, row), destination, { 0.0f, 0.0f }, 0.0f, WHITE);
+}
+
+/// <summary>
+/// Bakes the atlas, the window must be open.
+/// </summary>
+CardAtlas::CardAtlas()
+{
+	target = LoadRenderTexture(Columns * CellWidth, Rows * CellHeight);
+	BeginTextureMode(target);
+	ClearBackground(BLANK);
+	for (int row = 0; row < Rows; row++)
+	{
+		for (int column = 0; column < Columns; column++)
+		{
+			// Only the first cell of the last row is used, for the back
+			if (row == Rows - 1 && column > 0)
+			{
+				break;
+			}
+			float x = (float)(column * CellWidth);
+			float y = (float)(row * CellHeight);
+			DrawRectangleRounded({ x + 2.0f, y + 2.0f, CardWidth, CardHeight }, 0.2f, 10, BLACK);
+			DrawRectangleRounded({ x, y, CardWidth, CardHeight }, 0.2f, 10, LIGHTGRAY);
+			if (row == Rows - 1)
+			{
+				break;
+			}
+
+			// Suit above, rank below, red for diamonds and hearts
+			CardSuit suit = (CardSuit)row;
+			Color color = suit == DIAMONDS || suit == HEARTS ? MAROON : BLACK;
+			DrawSuit(suit, x + CardWidth / 2.0f, y + 28.0f, 12.0f, color);
+			const char* glyph = CardGlyphs[column];
+			DrawText(glyph, (int)(x + (CardWidth - MeasureText(glyph, 40)) / 2.0f), (int)y + 50, 40, color);
+		}
+	}
+	EndTextureMode();
+}
+
+/// <summary>
+/// Unloads the atlas.
+/// </summary>
+CardAtlas::~CardAtlas()
+{
+	UnloadRenderTexture(target);
+}
+
+/// <summary>
+/// Draws a card face up.
+/// </summary>
+/// <param name="card">The card.</param>
+/// <param name="x">The card's left edge.</param>
+/// <param name="y">The card's top edge.</param>
+/// <param name="width">How much of the card's width to draw about its middle, less than 1 while it turns over.</param>
+void CardAtlas::Draw(Card card, float x, float y, float width) const
+{
+	DrawCell(card.GetRank(), card.GetSuit(), x, y, width);
+}
+
+/// <summary>
+/// Draws a card face down.
+/// </summary>
+/// <param name="x">The card's left edge.</param>
+/// <param name="y">The card's top edge.</param>
+/// <param name="width">How much of the card's width to draw about its middle, less than 1 while it turns over.</param>
+void CardAtlas::DrawBack(float x, float y, float width) const
+{
+	DrawCell(0, Rows - 1, x, y, width);
+}
+
+/// <summary>
+/// Writes the atlas to an image, to check the faces on a machine with only software GL.
+/// </summary>
+/// <param name="path">The path of the image, its extension picks the format.</param>
+/// <returns>False if the image could not be written.</returns>
+bool CardAtlas::Export(const char* path) const
+{
+	Image image = LoadImageFromTexture(target.texture);
+	ImageFlipVertical(&image);
+	bool exported = ExportImage(image, path);
+	UnloadImage(image);
+	return exported;
+}
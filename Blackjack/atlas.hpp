@@ -0,0 +1,130 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "raylib.h"
+#include "cards.hpp"
+
+// Card faces baked into one texture so a hand draws as a single batch
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// Every card face and a card back, drawn once into a render texture.
+		/// <para>Faces sit in a row per suit and a column per rank with the back below them, each cell holds the card and its shadow.</para>
+		/// </summary>
+		class CardAtlas
+		{
+		public:
+			/// <summary>
+			/// The size of a card, and of a cell with room for its shadow.
+			/// </summary>
+			static constexpr float CardWidth = 60.0f;
+			static constexpr float CardHeight = 90.0f;
+			static constexpr int CellWidth = 64;
+			static constexpr int CellHeight = 94;
+
+			/// <summary>
+			/// Cells across and down, the last row only holds the back.
+			/// </summary>
+			static constexpr int Columns = 13;
+			static constexpr int Rows = 5;
+		private:
+			/// <summary>
+			/// The baked cells.
+			/// </summary>
+			RenderTexture2D target;
+
+			/// <summary>
+			/// Draws a suit symbol with shapes, the default font has no suit glyphs.
+			/// </summary>
+			/// <param name="suit">The suit.</param>
+			/// <param name="x">The symbol's center.</param>
+			/// <param name="y">The symbol's center.</param>
+			/// <param name="size">Half the symbol's width.</param>
+			/// <param name="color">The color.</param>
+			static void DrawSuit(CardSuit suit, float x, float y, float size, Color color);
+
+			/// <summary>
+			/// Gets the cell holding a card in the texture.
+			/// </summary>
+			/// <param name="column">The cell's column.</param>
+			/// <param name="row">The cell's row.</param>
+			/// <returns>The source rectangle, flipped because render textures are stored upside down.</returns>
+			Rectangle GetSource(int column, int row) const;
+
+			/// <summary>
+			/// Draws a cell, squeezed about its middle.
+			/// </summary>
+			/// <param name="column">The cell's column.</param>
+			/// <param name="row">The cell's row.</param>
+			/// <param name="x">The card's left edge.</param>
+			/// <param name="y">The card's top edge.</param>
+			/// <param name="width">How much of the card's width to draw.</param>
+			void DrawCell(int column, int row, float x, float y, float width) const;
+		public:
+			/// <summary>
+			/// Bakes the atlas, the window must be open.
+			/// </summary>
+			CardAtlas();
+
+			/// <summary>
+			/// Unloads the atlas.
+			/// </summary>
+			~CardAtlas();
+
+			CardAtlas(const CardAtlas&) = delete;
+			CardAtlas& operator=(const CardAtlas&) = delete;
+
+			/// <summary>
+			/// Draws a card face up.
+			/// </summary>
+			/// <param name="card">The card.</param>
+			/// <param name="x">The card's left edge.</param>
+			/// <param name="y">The card's top edge.</param>
+			/// <param name="width">How much of the card's width to draw about its middle, less than 1 while it turns over.</param>
+			void Draw(Card card, float x, float y, float width = 1.0f) const;
+
+			/// <summary>
+			/// Draws a card face down.
+			/// </summary>
+			/// <param name="x">The card's left edge.</param>
+			/// <param name="y">The card's top edge.</param>
+			/// <param name="width">How much of the card's width to draw about its middle, less than 1 while it turns over.</param>
+			void DrawBack(float x, float y, float width = 1.0f) const;
+
+			/// <summary>
+			/// Writes the atlas to an image, to check the faces on a machine with only software GL.
+			/// </summary>
+			/// <param name="path">The path of the image, its extension picks the format.</param>
+			/// <returns>False if the image could not be written.</returns>
+			bool Export(const char* path) const;
+		};
+	}
+}
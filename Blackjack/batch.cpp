@@ -0,0 +1,304 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "batchkernel.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+using namespace KiwifruitDev::Blackjack;
+
+namespace
+{
+	/// <summary>
+	/// Lanes as a plain array, the fallback for CPUs without AVX2 and the reference for the vector kernel.
+	/// </summary>
+	struct ScalarLanes
+	{
+		struct Type
+		{
+			int32_t v[BatchLanes];
+		};
+
+		static Type Set1(int32_t x)
+		{
+			Type r;
+			for (int i = 0; i < BatchLanes; i++) r.v[i] = x;
+			return r;
+		}
+
+		static Type Load(const int32_t* p)
+		{
+			Type r;
+			for (int i = 0; i < BatchLanes; i++) r.v[i] = p[i];
+			return r;
+		}
+
+		static void Store(int32_t* p, Type a)
+		{
+			for (int i = 0; i < BatchLanes; i++) p[i] = a.v[i];
+		}
+
+		static Type Add(Type a, Type b)
+		{
+			for (int i = 0; i < BatchLanes; i++) a.v[i] += b.v[i];
+			return a;
+		}
+
+		static Type Sub(Type a, Type b)
+		{
+			for (int i = 0; i < BatchLanes; i++) a.v[i] -= b.v[i];
+			return a;
+		}
+
+		static Type And(Type a, Type b)
+		{
+			for (int i = 0; i < BatchLanes; i++) a.v[i] &= b.v[i];
+			return a;
+		}
+
+		static Type Or(Type a, Type b)
+		{
+			for (int i = 0; i < BatchLanes; i++) a.v[i] |= b.v[i];
+			return a;
+		}
+
+		static Type AndNot(Type a, Type b)
+		{
+			for (int i = 0; i < BatchLanes; i++) a.v[i] = ~a.v[i] & b.v[i];
+			return a;
+		}
+
+		static Type CmpGt(Type a, Type b)
+		{
+			for (int i = 0; i < BatchLanes; i++) a.v[i] = a.v[i] > b.v[i] ? -1 : 0;
+			return a;
+		}
+
+		static Type CmpEq(Type a, Type b)
+		{
+			for (int i = 0; i < BatchLanes; i++) a.v[i] = a.v[i] == b.v[i] ? -1 : 0;
+			return a;
+		}
+
+		static Type Min(Type a, Type b)
+		{
+			for (int i = 0; i < BatchLanes; i++) a.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+			return a;
+		}
+
+		static Type ShiftRight(Type a, int bits)
+		{
+			for (int i = 0; i < BatchLanes; i++) a.v[i] = (int32_t)((uint32_t)a.v[i] >> bits);
+			return a;
+		}
+
+		static int MoveMask(Type a)
+		{
+			int mask = 0;
+			for (int i = 0; i < BatchLanes; i++) mask |= (a.v[i] < 0) << i;
+			return mask;
+		}
+	};
+}
+
+/// <summary>
+/// Starts a round on every lane, shuffling each shoe that has reached its cut card, like <see cref="BasicGame::Start"/>.
+/// </summary>
+/// <param name="state">The batch.</param>
+void KiwifruitDev::Blackjack::StartLanes(BatchState& state)
+{
+	for (int i = 0; i < BatchLanes; i++)
+	{
+		// Between rounds no cards are on the table, the whole shoe is shuffled.
+		if (state.shoes[i].NeedsShuffle())
+		{
+			state.shoes[i].Shuffle(state.rngs[i]);
+		}
+		state.inPlay[i] = 0;
+	}
+}
+
+/// <summary>
+/// Deals one card to every lane in a mask, like <see cref="BasicGame::PickCard"/>.
+/// <para>A lane's empty shoe only shuffles back the cards dealt before this round.</para>
+/// </summary>
+/// <param name="state">The batch.</param>
+/// <param name="mask">Bit n set deals to lane n.</param>
+/// <param name="codes">Receives each dealt card's packed code, other lanes are left as they are.</param>
+void KiwifruitDev::Blackjack::DrawLanes(BatchState& state, int mask, int32_t* codes)
+{
+	for (int i = 0; i < BatchLanes; i++)
+	{
+		if (mask & (1 << i))
+		{
+			if (state.shoes[i].IsEmpty())
+			{
+				state.inPlay[i] = state.shoes[i].Reshuffle(state.rngs[i], state.inPlay[i]);
+			}
+			state.inPlay[i]++;
+			codes[i] = state.shoes[i].Draw().code;
+		}
+	}
+}
+
+/// <summary>
+/// Plays rounds on every lane with plain scalar code.
+/// </summary>
+/// <param name="state">The batch.</param>
+/// <param name="rounds">The number of rounds each lane plays.</param>
+void KiwifruitDev::Blackjack::PlayBatchScalar(BatchState& state, long long rounds)
+{
+	PlayBatch<ScalarLanes>(state, rounds);
+}
+
+/// <summary>
+/// Constructor.
+/// </summary>
+/// <param name="hitMax">The player hits while their score is at most this.</param>
+/// <param name="decks">The number of decks in each lane's shoe.</param>
+/// <param name="streams">One random number generator per lane.</param>
+/// <param name="balance">The player's starting balance.</param>
+/// <param name="bet">The amount bet on every round.</param>
+BatchSimulator::BatchSimulator(int hitMax, int decks, const Xoshiro256 (&streams)[BatchLanes], int balance, int bet) : state()
+{
+	state.hitMax = hitMax;
+	state.balance = balance;
+	state.bet = bet;
+	for (int i = 0; i < BatchLanes; i++)
+	{
+		// The same setup as a game seeded with the stream, nothing is on the table yet.
+		state.shoes[i] = Shoe(decks);
+		state.rngs[i] = streams[i];
+		state.shoes[i].Shuffle(state.rngs[i]);
+		state.inPlay[i] = 0;
+		state.balances[i] = balance;
+	}
+}
+
+/// <summary>
+/// Plays rounds on every lane and collects the results of all lanes.
+/// <para>The bankroll trajectory only holds the starting and final bankroll.</para>
+/// <para>The lanes count whole units, the results are converted to cents like every other simulator.</para>
+/// </summary>
+/// <param name="rounds">The number of rounds each lane plays.</param>
+/// <param name="vectorized">Use AVX2 if the CPU supports it, otherwise always use the scalar kernel.</param>
+/// <returns>The results.</returns>
+SimulationResult BatchSimulator::Run(long long rounds, bool vectorized)
+{
+	SimulationResult result;
+	long long before = 0;
+	for (int i = 0; i < BatchLanes; i++)
+	{
+		before += state.net[i];
+	}
+	result.bankroll.push_back(Money::FromUnits((long long)state.balance * BatchLanes + before).cents);
+
+	// Count only this run.
+	BatchState totals = state;
+
+	auto start = std::chrono::steady_clock::now();
+	if (vectorized && IsVectorized())
+	{
+		PlayBatchAvx2(state, rounds);
+	}
+	else
+	{
+		PlayBatchScalar(state, rounds);
+	}
+	auto end = std::chrono::steady_clock::now();
+	result.seconds = std::chrono::duration<double>(end - start).count();
+
+	for (int i = 0; i < BatchLanes; i++)
+	{
+		result.wins += state.wins[i] - totals.wins[i];
+		result.losses += state.losses[i] - totals.losses[i];
+		result.pushes += state.pushes[i] - totals.pushes[i];
+		result.net += Money::FromUnits(state.net[i] - totals.net[i]).cents;
+	}
+	result.rounds = rounds * BatchLanes;
+	result.wagered = Money::FromUnits(result.rounds * state.bet).cents;
+	result.bankroll.push_back(result.bankroll.front() + result.net);
+
+	return result;
+}
+
+/// <summary>
+/// Checks if the CPU supports the AVX2 kernel.
+/// </summary>
+/// <returns>True if AVX2 is available.</returns>
+bool BatchSimulator::IsVectorized()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+	{
+		return false;
+	}
+	// The OS has to save the YMM registers too.
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+	{
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+/// <summary>
+/// Gets the hit threshold matching a built-in strategy.
+/// </summary>
+/// <param name="strategy">The strategy.</param>
+/// <param name="hitMax">Receives the threshold.</param>
+/// <returns>False if the strategy is not a threshold strategy.</returns>
+bool BatchSimulator::GetHitMax(Strategy strategy, int& hitMax)
+{
+	if (strategy == StandStrategy)
+	{
+		hitMax = 0;
+	}
+	else if (strategy == MimicDealerStrategy)
+	{
+		hitMax = 16;
+	}
+	else if (strategy == NeverBustStrategy)
+	{
+		hitMax = 11;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
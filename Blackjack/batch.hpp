@@ -0,0 +1,171 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "shoe.hpp"
+#include "simulator.hpp"
+
+// Batched simulation, several independent rounds per SIMD register
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// The number of independent games a batch plays side by side, one per 32 bit lane of an AVX2 register.
+		/// </summary>
+		const int BatchLanes = 8;
+
+		/// <summary>
+		/// State of every lane in a batch, laid out as arrays so a kernel can load all lanes at once.
+		/// <para>Each lane plays exactly what a <see cref="Simulator"/> with the same stream would play.</para>
+		/// </summary>
+		struct BatchState
+		{
+			/// <summary>
+			/// Each lane's shoe.
+			/// </summary>
+			Shoe shoes[BatchLanes];
+
+			/// <summary>
+			/// Each lane's random number generator.
+			/// </summary>
+			Xoshiro256 rngs[BatchLanes];
+
+			/// <summary>
+			/// The number of cards each lane has dealt this round, all still on its table.
+			/// </summary>
+			int inPlay[BatchLanes];
+
+			/// <summary>
+			/// Each lane's balance.
+			/// </summary>
+			alignas(32) int32_t balances[BatchLanes];
+
+			/// <summary>
+			/// Rounds won, lost and pushed, and net money won, by each lane.
+			/// </summary>
+			long long wins[BatchLanes];
+			long long losses[BatchLanes];
+			long long pushes[BatchLanes];
+			long long net[BatchLanes];
+
+			/// <summary>
+			/// The player hits while their score is at most this.
+			/// </summary>
+			int hitMax;
+
+			/// <summary>
+			/// The balance the player starts with, and rebuys to when broke.
+			/// </summary>
+			int balance;
+
+			/// <summary>
+			/// The amount bet on every round.
+			/// </summary>
+			int bet;
+		};
+
+		/// <summary>
+		/// Starts a round on every lane, shuffling each shoe that has reached its cut card, like <see cref="BasicGame::Start"/>.
+		/// <para>Kernels call this out of line so they never share inline code with other translation units.</para>
+		/// </summary>
+		/// <param name="state">The batch.</param>
+		void StartLanes(BatchState& state);
+
+		/// <summary>
+		/// Deals one card to every lane in a mask, like <see cref="BasicGame::PickCard"/>.
+		/// <para>A lane's empty shoe only shuffles back the cards dealt before this round.</para>
+		/// </summary>
+		/// <param name="state">The batch.</param>
+		/// <param name="mask">Bit n set deals to lane n.</param>
+		/// <param name="codes">Receives each dealt card's packed code, other lanes are left as they are.</param>
+		void DrawLanes(BatchState& state, int mask, int32_t* codes);
+
+		/// <summary>
+		/// Plays rounds on every lane with plain scalar code.
+		/// </summary>
+		/// <param name="state">The batch.</param>
+		/// <param name="rounds">The number of rounds each lane plays.</param>
+		void PlayBatchScalar(BatchState& state, long long rounds);
+
+		/// <summary>
+		/// Plays rounds on every lane with AVX2, only call this if <see cref="BatchSimulator::IsVectorized"/> is true.
+		/// </summary>
+		/// <param name="state">The batch.</param>
+		/// <param name="rounds">The number of rounds each lane plays.</param>
+		void PlayBatchAvx2(BatchState& state, long long rounds);
+
+		/// <summary>
+		/// Plays <see cref="BatchLanes"/> independent games at once.
+		/// <para>The strategy is a hit threshold so decisions can be made as a lane mask, which covers the stand, dealer and safe strategies.</para>
+		/// <para>Results match <see cref="Simulator"/> exactly, lane n plays what a simulator on stream n would play.</para>
+		/// <para>The kernel is built for the rules of <see cref="Game"/>, <see cref="StandardRules"/>.</para>
+		/// </summary>
+		class BatchSimulator
+		{
+		private:
+			/// <summary>
+			/// The lanes.
+			/// </summary>
+			BatchState state;
+		public:
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			/// <param name="hitMax">The player hits while their score is at most this.</param>
+			/// <param name="decks">The number of decks in each lane's shoe.</param>
+			/// <param name="streams">One random number generator per lane.</param>
+			/// <param name="balance">The player's starting balance.</param>
+			/// <param name="bet">The amount bet on every round.</param>
+			BatchSimulator(int hitMax, int decks, const Xoshiro256 (&streams)[BatchLanes], int balance = 1000, int bet = 10);
+
+			/// <summary>
+			/// Plays rounds on every lane and collects the results of all lanes.
+			/// <para>The bankroll trajectory only holds the starting and final bankroll.</para>
+			/// </summary>
+			/// <param name="rounds">The number of rounds each lane plays.</param>
+			/// <param name="vectorized">Use AVX2 if the CPU supports it, otherwise always use the scalar kernel.</param>
+			/// <returns>The results.</returns>
+			SimulationResult Run(long long rounds, bool vectorized = true);
+
+			/// <summary>
+			/// Checks if the CPU supports the AVX2 kernel.
+			/// </summary>
+			/// <returns>True if AVX2 is available.</returns>
+			static bool IsVectorized();
+
+			/// <summary>
+			/// Gets the hit threshold matching a built-in strategy.
+			/// </summary>
+			/// <param name="strategy">The strategy.</param>
+			/// <param name="hitMax">Receives the threshold.</param>
+			/// <returns>False if the strategy is not a threshold strategy.</returns>
+			static bool GetHitMax(Strategy strategy, int& hitMax);
+		};
+	}
+}
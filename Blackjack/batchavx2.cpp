@@ -0,0 +1,79 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Built with AVX2 enabled, see the project file.
+// Only PlayBatchAvx2 may run on CPUs without AVX2, so nothing here is shared with other translation units.
+
+#include "batchkernel.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+
+using namespace KiwifruitDev::Blackjack;
+
+namespace
+{
+	/// <summary>
+	/// Lanes in an AVX2 register.
+	/// </summary>
+	struct Avx2Lanes
+	{
+		typedef __m256i Type;
+
+		static Type Set1(int32_t x) { return _mm256_set1_epi32(x); }
+		static Type Load(const int32_t* p) { return _mm256_load_si256((const __m256i*)p); }
+		static void Store(int32_t* p, Type a) { _mm256_store_si256((__m256i*)p, a); }
+		static Type Add(Type a, Type b) { return _mm256_add_epi32(a, b); }
+		static Type Sub(Type a, Type b) { return _mm256_sub_epi32(a, b); }
+		static Type And(Type a, Type b) { return _mm256_and_si256(a, b); }
+		static Type Or(Type a, Type b) { return _mm256_or_si256(a, b); }
+		static Type AndNot(Type a, Type b) { return _mm256_andnot_si256(a, b); }
+		static Type CmpGt(Type a, Type b) { return _mm256_cmpgt_epi32(a, b); }
+		static Type CmpEq(Type a, Type b) { return _mm256_cmpeq_epi32(a, b); }
+		static Type Min(Type a, Type b) { return _mm256_min_epi32(a, b); }
+		static Type ShiftRight(Type a, int bits) { return _mm256_srli_epi32(a, bits); }
+		static int MoveMask(Type a) { return _mm256_movemask_ps(_mm256_castsi256_ps(a)); }
+	};
+}
+
+/// <summary>
+/// Plays rounds on every lane with AVX2, only call this if <see cref="BatchSimulator::IsVectorized"/> is true.
+/// </summary>
+/// <param name="state">The batch.</param>
+/// <param name="rounds">The number of rounds each lane plays.</param>
+void KiwifruitDev::Blackjack::PlayBatchAvx2(BatchState& state, long long rounds)
+{
+	PlayBatch<Avx2Lanes>(state, rounds);
+}
+#else
+/// <summary>
+/// No AVX2 on this architecture, <see cref="BatchSimulator::IsVectorized"/> is always false.
+/// </summary>
+void KiwifruitDev::Blackjack::PlayBatchAvx2(BatchState& state, long long rounds)
+{
+	PlayBatchScalar(state, rounds);
+}
+#endif
@@ -0,0 +1,221 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "batch.hpp"
+
+// The batch kernel, written once against a lane type.
+// Include this only from the file that instantiates it, with the lane type in an anonymous namespace.
+// The kernel must not call inline code from other headers, each instantiation may be built for a different instruction set.
+//
+// A lane type L provides L::Type holding BatchLanes 32 bit integers and these static functions:
+// Set1, Load, Store, Add, Sub, And, Or, AndNot(a, b) = ~a & b, CmpGt, CmpEq, Min, ShiftRight, MoveMask.
+// Comparisons return all ones in lanes where they hold.
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// Points for packed card codes, aces counted as 1.
+		/// <para>The same as <see cref="CardPoints"/>, min(value + 1, 10).</para>
+		/// </summary>
+		template <typename L>
+		inline typename L::Type LanePoints(typename L::Type codes)
+		{
+			return L::Min(L::Add(L::ShiftRight(codes, 2), L::Set1(1)), L::Set1(10));
+		}
+
+		/// <summary>
+		/// 1 for aces, 0 for anything else.
+		/// </summary>
+		template <typename L>
+		inline typename L::Type LaneAces(typename L::Type codes)
+		{
+			return L::And(L::CmpGt(L::Set1(4), codes), L::Set1(1));
+		}
+
+		/// <summary>
+		/// Scores hands from their hard score and ace count, the same as <see cref="Hand::GetScore"/>.
+		/// </summary>
+		template <typename L>
+		inline typename L::Type LaneScore(typename L::Type hard, typename L::Type aces)
+		{
+			typename L::Type soft = L::And(L::CmpGt(aces, L::Set1(0)), L::CmpGt(L::Set1(12), hard));
+			return L::Add(hard, L::And(soft, L::Set1(10)));
+		}
+
+		/// <summary>
+		/// Adds 64 bit lane totals to a batch and clears the 32 bit counters.
+		/// </summary>
+		template <typename L>
+		inline void FlushLanes(typename L::Type& counter, long long* totals)
+		{
+			alignas(32) int32_t values[BatchLanes];
+			L::Store(values, counter);
+			for (int i = 0; i < BatchLanes; i++)
+			{
+				totals[i] += values[i];
+			}
+			counter = L::Set1(0);
+		}
+
+		/// <summary>
+		/// Plays rounds on every lane of a batch.
+		/// <para>Follows <see cref="Simulator::PlayRound"/> and the <see cref="BasicGame"/> state machine step for step.</para>
+		/// </summary>
+		/// <param name="state">The batch.</param>
+		/// <param name="rounds">The number of rounds each lane plays.</param>
+		template <typename L>
+		void PlayBatch(BatchState& state, long long rounds)
+		{
+			typedef typename L::Type V;
+
+			const V zero = L::Set1(0);
+			const V bet = L::Set1(state.bet);
+			const V start = L::Set1(state.balance);
+			// Wins pay even money, naturals pay the blackjack payout truncated by the integer balance.
+			const V blackjackPay = L::Set1(state.bet * StandardRules::blackjackNumerator / StandardRules::blackjackDenominator);
+			const V hitBelow = L::Set1(state.hitMax + 1);
+			const V seventeen = L::Set1(17);
+			const V twentyOne = L::Set1(21);
+			const V hardEight = L::Set1(8);
+
+			alignas(32) int32_t codes[BatchLanes] = {};
+			V balance = L::Load(state.balances);
+			V wins = zero;
+			V losses = zero;
+			V pushes = zero;
+			V net = zero;
+
+			for (long long round = 0; round < rounds; round++)
+			{
+				// Rebuy if the player can no longer cover the bet.
+				balance = L::Or(L::And(L::CmpGt(bet, balance), start), L::AndNot(L::CmpGt(bet, balance), balance));
+				V before = balance;
+
+				StartLanes(state);
+
+				// Two cards for the house, two for the player.
+				DrawLanes(state, 0xFF, codes);
+				V card = L::Load(codes);
+				V dealerHard = LanePoints<L>(card);
+				V dealerAces = LaneAces<L>(card);
+				DrawLanes(state, 0xFF, codes);
+				card = L::Load(codes);
+				dealerHard = L::Add(dealerHard, LanePoints<L>(card));
+				dealerAces = L::Add(dealerAces, LaneAces<L>(card));
+				V dealerScore = LaneScore<L>(dealerHard, dealerAces);
+				V dealerBlackjack = L::CmpEq(dealerScore, twentyOne);
+				DrawLanes(state, 0xFF, codes);
+				card = L::Load(codes);
+				V playerHard = LanePoints<L>(card);
+				V playerAces = LaneAces<L>(card);
+				DrawLanes(state, 0xFF, codes);
+				card = L::Load(codes);
+				playerHard = L::Add(playerHard, LanePoints<L>(card));
+				playerAces = L::Add(playerAces, LaneAces<L>(card));
+				V playerScore = LaneScore<L>(playerHard, playerAces);
+
+				// Naturals settle straight away.
+				V natural = L::CmpEq(playerScore, twentyOne);
+				V naturalWin = L::AndNot(dealerBlackjack, natural);
+				V naturalPush = L::And(dealerBlackjack, natural);
+
+				// The player hits until over the threshold, a bust or 21 finishes the hand.
+				V hit = L::AndNot(natural, L::CmpGt(hitBelow, playerScore));
+				int mask;
+				while ((mask = L::MoveMask(hit)) != 0)
+				{
+					DrawLanes(state, mask, codes);
+					card = L::Load(codes);
+					playerHard = L::Add(playerHard, L::And(hit, LanePoints<L>(card)));
+					playerAces = L::Add(playerAces, L::And(hit, LaneAces<L>(card)));
+					playerScore = LaneScore<L>(playerHard, playerAces);
+					// Thresholds are below 21, so a bust or 21 always stops here.
+					hit = L::And(hit, L::CmpGt(hitBelow, playerScore));
+				}
+				V bust = L::CmpGt(playerScore, twentyOne);
+				V settled = L::Or(natural, bust);
+
+				// The house draws to 17 on every lane still playing, and on soft 17 under H17.
+				V draw = L::CmpGt(seventeen, dealerScore);
+				if (StandardRules::hitSoft17)
+				{
+					V soft17 = L::And(L::CmpEq(dealerScore, seventeen), L::CmpGt(hardEight, dealerHard));
+					draw = L::Or(draw, soft17);
+				}
+				draw = L::AndNot(settled, draw);
+				while ((mask = L::MoveMask(draw)) != 0)
+				{
+					DrawLanes(state, mask, codes);
+					card = L::Load(codes);
+					dealerHard = L::Add(dealerHard, L::And(draw, LanePoints<L>(card)));
+					dealerAces = L::Add(dealerAces, L::And(draw, LaneAces<L>(card)));
+					dealerScore = LaneScore<L>(dealerHard, dealerAces);
+					V more = L::CmpGt(seventeen, dealerScore);
+					if (StandardRules::hitSoft17)
+					{
+						V soft17 = L::And(L::CmpEq(dealerScore, seventeen), L::CmpGt(hardEight, dealerHard));
+						more = L::Or(more, soft17);
+					}
+					draw = L::AndNot(settled, more);
+				}
+				V dealerBust = L::AndNot(settled, L::CmpGt(dealerScore, twentyOne));
+				V compare = L::AndNot(L::Or(settled, dealerBust), L::CmpEq(zero, zero));
+
+				// Settle, a dealer blackjack beats any other 21.
+				V win = L::Or(dealerBust, L::And(compare, L::CmpGt(playerScore, dealerScore)));
+				V lose = L::Or(bust, L::And(compare, L::Or(L::CmpGt(dealerScore, playerScore), dealerBlackjack)));
+				V push = L::Or(naturalPush, L::AndNot(dealerBlackjack, L::And(compare, L::CmpEq(playerScore, dealerScore))));
+				balance = L::Sub(L::Add(balance, L::Add(L::And(win, bet), L::And(naturalWin, blackjackPay))), L::And(lose, bet));
+				win = L::Or(win, naturalWin);
+
+				// Masks are -1 where set.
+				wins = L::Sub(wins, win);
+				losses = L::Sub(losses, lose);
+				pushes = L::Sub(pushes, push);
+				net = L::Add(net, L::Sub(balance, before));
+
+				// Keep the 32 bit counters far from overflowing.
+				if ((round & 0xFFFF) == 0xFFFF)
+				{
+					FlushLanes<L>(wins, state.wins);
+					FlushLanes<L>(losses, state.losses);
+					FlushLanes<L>(pushes, state.pushes);
+					FlushLanes<L>(net, state.net);
+				}
+			}
+
+			FlushLanes<L>(wins, state.wins);
+			FlushLanes<L>(losses, state.losses);
+			FlushLanes<L>(pushes, state.pushes);
+			FlushLanes<L>(net, state.net);
+			L::Store(state.balances, balance);
+		}
+	}
+}
@@ -0,0 +1,370 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "frame.hpp"
+#include "game.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace KiwifruitDev::Blackjack;
+
+// Microbenchmark executable
+// Usage: Bench [--time seconds] [--filter text] [--save file] [--baseline file] [--threshold percent]
+//
+// Every benchmark reports ns/op and heap allocations per operation.
+// --save writes the results as a baseline, --baseline compares against one and fails if anything regressed.
+// The benchmarks a frame runs must never allocate, Bench fails if one of them does even without a baseline.
+
+// Every allocation in the process is counted, the benchmarks run on one thread.
+static long long allocations = 0;
+
+void* operator new(size_t size)
+{
+	allocations++;
+	void* memory = malloc(size == 0 ? 1 : size);
+	if (memory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+// Benchmarks standing in for work done every frame, which must make no heap allocations once warmed up.
+static const char* const steadyState[] = { "Hand::AddCard", "Hand::GetCards", "Game::Round", "Frame::Update" };
+
+// Keeps results alive so the work producing them is not optimized away.
+static volatile long long sink = 0;
+
+// One benchmark's numbers.
+struct BenchResult
+{
+	std::string name;
+	double nanoseconds;
+	double allocations;
+};
+
+// Times a body that runs one operation per call.
+// The iteration count grows until a run takes a tenth of the time budget, then the fastest of several runs is kept.
+template <typename Body>
+BenchResult Measure(const char* name, double seconds, Body body)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	// Warm up, and find an iteration count worth timing.
+	long long iterations = 1;
+	for (;;)
+	{
+		auto start = Clock::now();
+		for (long long i = 0; i < iterations; i++)
+		{
+			body();
+		}
+		double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		if (elapsed >= seconds / 10.0 || iterations >= (1ll << 40))
+		{
+			break;
+		}
+		iterations *= 2;
+	}
+
+	double best = 1e300;
+	long long allocated = 0;
+	long long runs = 0;
+	auto budget = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+	do
+	{
+		long long before = allocations;
+		auto start = Clock::now();
+		for (long long i = 0; i < iterations; i++)
+		{
+			body();
+		}
+		double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		allocated += allocations - before;
+		runs++;
+		best = std::min(best, elapsed / iterations);
+	} while (Clock::now() < budget || runs < 3);
+
+	return BenchResult{ name, best, (double)allocated / (runs * iterations) };
+}
+
+// Reads a baseline written by --save.
+static bool LoadBaseline(const char* path, std::vector<BenchResult>& baseline)
+{
+	FILE* file = fopen(path, "r");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	char name[128];
+	double nanoseconds, allocs;
+	while (fscanf(file, "%127s %lf %lf", name, &nanoseconds, &allocs) == 3)
+	{
+		baseline.push_back(BenchResult{ name, nanoseconds, allocs });
+	}
+	fclose(file);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	double seconds = 0.5;
+	const char* filter = nullptr;
+	const char* savePath = nullptr;
+	const char* baselinePath = nullptr;
+	double threshold = 10.0;
+
+	// Parse options
+	for (int i = 1; i < argc; i++)
+	{
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		if (value == nullptr)
+		{
+			fprintf(stderr, "Missing value for \"%s\".\n", argv[i]);
+			return 1;
+		}
+		else if (strcmp(argv[i], "--time") == 0)
+		{
+			seconds = atof(value);
+		}
+		else if (strcmp(argv[i], "--filter") == 0)
+		{
+			filter = value;
+		}
+		else if (strcmp(argv[i], "--save") == 0)
+		{
+			savePath = value;
+		}
+		else if (strcmp(argv[i], "--baseline") == 0)
+		{
+			baselinePath = value;
+		}
+		else if (strcmp(argv[i], "--threshold") == 0)
+		{
+			threshold = atof(value);
+		}
+		else
+		{
+			fprintf(stderr, "Unknown option \"%s\".\n", argv[i]);
+			return 1;
+		}
+		i++;
+	}
+
+	std::vector<BenchResult> baseline;
+	if (baselinePath != nullptr && !LoadBaseline(baselinePath, baseline))
+	{
+		fprintf(stderr, "Could not read a baseline from \"%s\".\n", baselinePath);
+		return 1;
+	}
+
+	// Everything runs against the window's rules, with a fixed seed.
+	RuntimeRules rules;
+	rules.decks = 1;
+	RuntimeGame game(rules, 0.75f, 1);
+	std::vector<BenchResult> results;
+	auto wanted = [&](const char* name) { return filter == nullptr || strstr(name, filter) != nullptr; };
+
+	if (wanted("Game::PopulateDeck"))
+	{
+		results.push_back(Measure("Game::PopulateDeck", seconds, [&]()
+		{
+			game.PopulateDeck();
+		}));
+	}
+
+	if (wanted("Game::PickCard"))
+	{
+		results.push_back(Measure("Game::PickCard", seconds, [&]()
+		{
+			sink += game.PickCard().code;
+		}));
+	}
+
+	if (wanted("Hand::AddCard"))
+	{
+		// A hand holds at most a few cards, so it is reset between adds.
+		Hand hand;
+		Card card(CardValue::TWO, CardSuit::HEARTS);
+		results.push_back(Measure("Hand::AddCard", seconds, [&]()
+		{
+			if (hand.GetCount() >= 8)
+			{
+				hand.Reset();
+			}
+			hand.AddCard(card);
+		}));
+		sink += hand.GetScore();
+	}
+
+	if (wanted("Hand::GetCards"))
+	{
+		Hand hand;
+		hand.AddCard(Card(CardValue::ACE, CardSuit::SPADES));
+		hand.AddCard(Card(CardValue::SEVEN, CardSuit::CLUBS));
+		results.push_back(Measure("Hand::GetCards", seconds, [&]()
+		{
+			CardView cards = hand.GetCards();
+			sink += cards.size() + cards[0].code;
+		}));
+	}
+
+	if (wanted("Game::Round"))
+	{
+		// Start, deal, then hit below 17 and stand, the same round the window plays.
+		results.push_back(Measure("Game::Round", seconds, [&]()
+		{
+			game.GetPlayer()->SetBalance(Money::FromUnits(1000));
+			game.Start();
+			game.Deal(false);
+			game.Deal(false);
+			game.DealPlayer();
+			game.DealPlayer();
+			while (game.GetState() == GameState::Active)
+			{
+				if (game.GetPlayer()->GetHand()->GetScore() < 17)
+				{
+					game.Hit();
+				}
+				else
+				{
+					game.Stand();
+				}
+			}
+			sink += game.GetState();
+		}));
+	}
+
+	if (wanted("Frame::Update"))
+	{
+		// The player standing as soon as it is their turn and dealing again once it is over.
+		game.GetPlayer()->SetBalance(Money::FromUnits(1000));
+		game.Start();
+		Frame frame(&game);
+		results.push_back(Measure("Frame::Update", seconds, [&]()
+		{
+			FrameInput input = InputNone;
+			if (game.GetState() == GameState::Active)
+			{
+				input = InputStand;
+			}
+			else if (game.GetState() != GameState::Waiting)
+			{
+				game.GetPlayer()->SetBalance(Money::FromUnits(1000));
+				input = InputReset;
+			}
+			sink += frame.Update(input);
+		}));
+	}
+
+	// Report, next to the baseline if there is one
+	bool regressed = false;
+	printf("%-20s %12s %12s", "Benchmark", "ns/op", "allocs/op");
+	if (!baseline.empty())
+	{
+		printf(" %12s %9s", "baseline", "change");
+	}
+	printf("\n");
+	for (const BenchResult& result : results)
+	{
+		printf("%-20s %12.2f %12.2f", result.name.c_str(), result.nanoseconds, result.allocations);
+		auto match = std::find_if(baseline.begin(), baseline.end(), [&](const BenchResult& entry) { return entry.name == result.name; });
+		if (match != baseline.end())
+		{
+			double change = 100.0 * (result.nanoseconds - match->nanoseconds) / match->nanoseconds;
+			bool slower = change > threshold;
+			bool allocating = result.allocations > match->allocations + 0.01;
+			printf(" %12.2f %+8.1f%%%s%s", match->nanoseconds, change, slower ? " SLOWER" : "", allocating ? " ALLOCATES" : "");
+			regressed = regressed || slower || allocating;
+		}
+		printf("\n");
+	}
+
+	// The warm-up runs are not counted, so any allocation left is one every frame would make
+	bool allocating = false;
+	for (const BenchResult& result : results)
+	{
+		bool steady = std::any_of(std::begin(steadyState), std::end(steadyState), [&](const char* name) { return result.name == name; });
+		if (steady && result.allocations > 0.0)
+		{
+			printf("%s allocates %.2f times per operation in steady state.\n", result.name.c_str(), result.allocations);
+			allocating = true;
+		}
+	}
+
+	if (savePath != nullptr)
+	{
+		FILE* file = fopen(savePath, "w");
+		if (file == nullptr)
+		{
+			fprintf(stderr, "Could not open \"%s\" for writing.\n", savePath);
+			return 1;
+		}
+		for (const BenchResult& result : results)
+		{
+			fprintf(file, "%s %.3f %.3f\n", result.name.c_str(), result.nanoseconds, result.allocations);
+		}
+		fclose(file);
+	}
+
+	if (regressed)
+	{
+		printf("Regressed against the baseline by more than %.1f%%.\n", threshold);
+	}
+	return regressed || allocating ? 1 : 0;
+}
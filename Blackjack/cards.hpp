@@ -26,6 +26,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 // Blackjack card definitions
 
 namespace KiwifruitDev
@@ -57,48 +59,100 @@ namespace KiwifruitDev
 			KING
 		};
 		
+		/// <summary>
+		/// Points each card value is worth, indexed by <see cref="CardValue"/>.
+		/// <para>Aces are worth 1 here, a hand decides if one of its aces should count as 11.</para>
+		/// </summary>
+		constexpr uint8_t CardPoints[13] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10 };
+
+		/// <summary>
+		/// Display text for each card value, indexed by <see cref="CardValue"/>.
+		/// </summary>
+		constexpr const char* CardGlyphs[13] = { "A", "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K" };
+
+		/// <summary>
+		/// Display text for each suit, indexed by <see cref="CardSuit"/>.
+		/// </summary>
+		constexpr const char* SuitGlyphs[4] = { "C", "D", "H", "S" };
+		
 		/// <summary>
 		/// Card struct to hold the value and suit of a card.
+		/// <para>Both are packed into a single byte, the value in the upper bits and the suit in the lower two.</para>
 		/// </summary>
 		struct Card {
+			/// <summary>
+			/// The packed value and suit.
+			/// </summary>
+			uint8_t code;
+
 			/// <summary>
 			/// Constructor to create a card.
 			/// </summary>
 			/// <param name="value">The value of the card.</param>
 			/// <param name="suit">The suit of the card.</param>
-			Card(CardValue value, CardSuit suit) : value(value), suit(suit) {}
-			
+			constexpr Card(CardValue value, CardSuit suit) : code((uint8_t)(value << 2 | suit)) {}
+
 			/// <summary>
-			/// The suit of the card.
+			/// Default constructor, creates an ace of clubs.
 			/// </summary>
-			CardSuit suit;
+			constexpr Card() : code(0) {}
 
 			/// <summary>
-			/// The visual value of the card.
-			/// <para>See <see cref="Card::GetValue"/> for the actual value.</para>
+			/// Gets the suit of the card.
 			/// </summary>
-			CardValue value;
+			/// <returns>The suit.</returns>
+			constexpr CardSuit GetSuit() const
+			{
+				return (CardSuit)(code & 3);
+			}
 
-			/// <summary>This will provide the card's actual value.</summary>
-			/// <param name="score">The current hand. Used to determine if an ace should be 1 or 11.</param>
-			/// <returns>The card's actual value.</returns>
-			int GetValue(int score)
+			/// <summary>
+			/// Gets the visual value of the card.
+			/// <para>See <see cref="Card::GetPoints"/> for the actual value.</para>
+			/// </summary>
+			/// <returns>The visual value.</returns>
+			constexpr CardValue GetRank() const
 			{
-				switch (value)
-				{
-				case ACE:
-					// Calculate if the ace should be 1 or 11
-					return score + 11 > 21 ? 1 : 11;
-				case JACK:
-				case QUEEN:
-				case KING:
-					// Face cards are worth 10
-					return 10;
-				default:
-					// All other cards are worth their number
-					return value + 1;
-				}
+				return (CardValue)(code >> 2);
+			}
+
+			/// <summary>
+			/// Gets the points the card is worth, counting aces as 1.
+			/// </summary>
+			/// <returns>The points.</returns>
+			constexpr int GetPoints() const
+			{
+				return CardPoints[code >> 2];
+			}
+
+			/// <summary>
+			/// Checks if the card is an ace.
+			/// </summary>
+			/// <returns>True if the card is an ace.</returns>
+			constexpr bool IsAce() const
+			{
+				return code < 4;
+			}
+
+			/// <summary>
+			/// Gets the display text of the card's value.
+			/// </summary>
+			/// <returns>The display text.</returns>
+			constexpr const char* GetGlyph() const
+			{
+				return CardGlyphs[code >> 2];
+			}
+
+			/// <summary>
+			/// Gets the display text of the card's suit.
+			/// </summary>
+			/// <returns>The display text.</returns>
+			constexpr const char* GetSuitGlyph() const
+			{
+				return SuitGlyphs[code & 3];
 			}
 		};
+
+		static_assert(sizeof(Card) == 1, "Card should be packed into one byte");
 	}
 }
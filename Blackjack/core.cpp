@@ -25,70 +25,106 @@
 */
 
 #include "raylib.h"
+#include "animation.hpp"
+#include "atlas.hpp"
+#include "frame.hpp"
 #include "game.hpp"
+#include "history.hpp"
+#include "logic.hpp"
+#include "profiler.hpp"
 #include <sounds.hpp>
+#include <cstdio>
+#include <cstdlib>
 
 using namespace KiwifruitDev::Blackjack;
 
 // Core executable file
 
-void DrawCard(Card card, int i, float y)
+void DrawProfiler(Profiler& profiler, int x, int y, long long framesRendered, long long framesSkipped)
 {
-	// Draw symbol (text character for now)
-	switch (card.suit)
+	int zoneCount = 0;
+	const Profiler::ZoneStats* zones = profiler.GetZones(zoneCount);
+	DrawRectangle(x, y, 250, 144 + (zoneCount * 14), { 0, 0, 0, 190 });
+
+	// Percentiles over the last ten seconds
+	char text[64];
+	FrameStats stats = profiler.GetFrameStats();
+	sprintf_s(text, "%d FPS, %d frames", GetFPS(), stats.frames);
+	DrawText(text, x + 6, y + 6, 10, WHITE);
+	sprintf_s(text, "p50 %.2f  p90 %.2f ms", stats.p50, stats.p90);
+	DrawText(text, x + 6, y + 20, 10, WHITE);
+	sprintf_s(text, "p99 %.2f  max %.2f ms", stats.p99, stats.max);
+	DrawText(text, x + 6, y + 34, 10, stats.p99 > 1000.0 / 60.0 ? RED : WHITE);
+
+	// Frame times, newest on the right, the line is a 60 FPS frame
+	const int graphHeight = 60;
+	const double graphScale = graphHeight / 33.3;
+	for (int i = 0; i < 238; i++)
+	{
+		double milliseconds = profiler.GetFrameTime(i);
+		int height = milliseconds * graphScale > graphHeight ? graphHeight : (int)(milliseconds * graphScale);
+		DrawRectangle(x + 244 - i, y + 50 + graphHeight - height, 1, height, milliseconds > 1000.0 / 60.0 ? RED : GREEN);
+	}
+	DrawLine(x + 6, y + 50 + graphHeight - (int)(1000.0 / 60.0 * graphScale), x + 244, y + 50 + graphHeight - (int)(1000.0 / 60.0 * graphScale), YELLOW);
+
+	// Frames drawn against frames skipped while idle
+	sprintf_s(text, "Drawn %lld, skipped %lld", framesRendered, framesSkipped);
+	DrawText(text, x + 6, y + 120, 10, WHITE);
+
+	// Average time in each zone, nested zones indented
+	for (int i = 0; i < zoneCount; i++)
+	{
+		if (zones[i].average < 0.0)
+		{
+			continue;
+		}
+		sprintf_s(text, "%*s%-14s %6.3f ms", zones[i].depth * 2, "", zones[i].name, zones[i].average);
+		DrawText(text, x + 6, y + 134 + (i * 14), 10, LIGHTGRAY);
+	}
+}
+
+void DrawAutoplay(const AutoplayStats& stats, int x, int y)
+{
+	DrawRectangle(x, y, 250, 150, { 0, 0, 0, 190 });
+
+	char text[64];
+	sprintf_s(text, "Autoplay: %lld rounds, %.0f hands/s", stats.rounds, stats.handsPerSecond);
+	DrawText(text, x + 6, y + 6, 10, WHITE);
+	unsigned long long magnitude = stats.net < 0 ? 0ull - (unsigned long long)stats.net : (unsigned long long)stats.net;
+	sprintf_s(text, "EV %+.2f%%, net %s%llu.%02llu, rebuys %d", stats.GetEV() * 100.0, stats.net < 0 ? "-" : "", magnitude / 100, magnitude % 100, stats.rebuys);
+	DrawText(text, x + 6, y + 20, 10, stats.net < 0 ? RED : GREEN);
+
+	// Bankroll over every round played, scaled to fit
+	if (stats.bankrollCount < 2)
+	{
+		return;
+	}
+	long long low = stats.bankroll[0];
+	long long high = stats.bankroll[0];
+	for (int i = 1; i < stats.bankrollCount; i++)
 	{
-	case CardSuit::CLUBS:
-		DrawText("C", 20 + (i * 70), y + 10, 40, BLACK);
-		break;
-	case CardSuit::DIAMONDS:
-		DrawText("D", 20 + (i * 70), y + 10, 40, BLACK);
-		break;
-	case CardSuit::HEARTS:
-		DrawText("H", 20 + (i * 70), y + 10, 40, BLACK);
-		break;
-	case CardSuit::SPADES:
-		DrawText("S", 20 + (i * 70), y + 10, 40, BLACK);
-		break;
+		low = stats.bankroll[i] < low ? stats.bankroll[i] : low;
+		high = stats.bankroll[i] > high ? stats.bankroll[i] : high;
 	}
-	// Draw value
-	switch (card.value)
+	const int graphWidth = 238;
+	const int graphHeight = 100;
+	double scale = high > low ? (double)graphHeight / (high - low) : 0.0;
+	Vector2 points[AutoplayStats::BankrollSamples];
+	for (int i = 0; i < stats.bankrollCount; i++)
 	{
-	case CardValue::ACE:
-		DrawText("A", 20 + (i * 70), y + 50, 40, BLACK);
-		break;
-	case CardValue::TEN:
-		DrawText("10", 20 + (i * 70), y + 50, 40, BLACK);
-		break;
-	case CardValue::JACK:
-		DrawText("J", 20 + (i * 70), y + 50, 40, BLACK);
-		break;
-	case CardValue::QUEEN:
-		DrawText("Q", 20 + (i * 70), y + 50, 40, BLACK);
-		break;
-	case CardValue::KING:
-		DrawText("K", 20 + (i * 70), y + 50, 40, BLACK);
-		break;
-	default:
-		char value[2];
-		sprintf(value, "%d", card.value + 1);
-		DrawText(value, 20 + (i * 70), y + 50, 40, BLACK);
-		break;
+		points[i] = { (float)(x + 6) + (float)i * graphWidth / (stats.bankrollCount - 1), (float)(y + 40 + graphHeight) - (float)((stats.bankroll[i] - low) * scale) };
 	}
+	DrawLineStrip(points, stats.bankrollCount, GOLD);
+	sprintf_s(text, "%lld", high / 100);
+	DrawText(text, x + 6, y + 36, 10, LIGHTGRAY);
+	sprintf_s(text, "%lld", low / 100);
+	DrawText(text, x + 6, y + 134, 10, LIGHTGRAY);
 }
 
 int main(void)
 {
     const int screenWidth = 780;
     const int screenHeight = 450;
-	double startTime = 0.0;
-	double time = 0.0;
-	bool dealerDealt = false;
-	bool playerDealt = false;
-	bool dealerRevealed = false;
-	double nextAnimTimeInterval = 0.25;
-	double nextAnimTime = nextAnimTimeInterval;
-	bool gameEnd = true;
-
 	Rectangle hitButtonShadow = { 12.0f, 302.0f, 120.0f, 40.0f };
 	Rectangle hitButton = { 10.0f, 300.0f, 120.0f, 40.0f };
 	
@@ -101,124 +137,227 @@ int main(void)
 	Rectangle resetButtonShadow = { 402.0f, 302.0f, 120.0f, 40.0f };
 	Rectangle resetButton = { 400.0f, 300.0f, 120.0f, 40.0f };
 
+	Rectangle doubleButtonShadow = { 532.0f, 302.0f, 120.0f, 40.0f };
+	Rectangle doubleButton = { 530.0f, 300.0f, 120.0f, 40.0f };
+
+	Rectangle splitButtonShadow = { 662.0f, 302.0f, 108.0f, 40.0f };
+	Rectangle splitButton = { 660.0f, 300.0f, 108.0f, 40.0f };
+
     InitWindow(screenWidth, screenHeight, "raylib-stuff: Blackjack");
 	InitAudioDevice();
 
 	SetTargetFPS(60);
 	
-	globalGame = new Game();
+	// The window plays a single deck.
+	RuntimeRules rules;
+	rules.decks = 1;
+	// Every session is recorded until autoplay takes over, the seed in the log deals it again.
+	uint64_t seed = (uint64_t)std::random_device()() << 32 | std::random_device()();
+	globalGame = new RuntimeGame(rules, 0.75f, seed);
+	HistoryWriter* history = new HistoryWriter("history.bjh", HistoryHeader::Describe(rules, 0.75f, seed));
+	if (history->IsOpen())
+	{
+		globalGame->SetHistory(history);
+	}
 	globalSounds = new Sounds();
 	globalGame->Start();
+	// The game runs on its own thread from here, the window only sees snapshots of it
+	LogicThread* logic = new LogicThread(globalGame);
+	uint32_t sent = 0;
+	uint32_t clicksPlayed = 0;
+	// Every card the game deals is flown in from the shoe, one after another
+	TableAnimation animation;
+	const Vector2 shoe = { 700.0f, 50.0f };
+	// F3 shows frame times, F4 writes every recorded zone to trace.json
+	Profiler profiler;
+	bool showProfiler = false;
+	// Everything that never changes, backdrop, buttons, labels and titles
+	RenderTexture2D staticLayer = LoadRenderTexture(screenWidth, screenHeight);
+	bool staticDirty = true;
+	// Every card face, F5 writes them to atlas.png
+	CardAtlas* cardAtlas = new CardAtlas();
+	// F6 switches between drawing every frame and drawing only when something changed
+	bool eventDriven = true;
+	bool redraw = true;
+	uint32_t drawnVersion = 0;
+	long long framesRendered = 0;
+	long long framesSkipped = 0;
 
 	while (!WindowShouldClose())
 	{
+		profiler.BeginFrame();
+
 		// Update //
-		time = GetTime() - startTime;
-		std::vector<Card> house = globalGame->GetHand()->GetCards();
-		std::vector<Card> playerHand = globalGame->GetPlayer()->GetCards();
+		// Detect button click
+		profiler.Begin("Input");
+		FrameInput input = InputNone;
+		Vector2 mousePos = GetMousePosition();
+		if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+		{
+			if (CheckCollisionPointRec(mousePos, hitButton))
+				input = InputHit;
+			else if (CheckCollisionPointRec(mousePos, standButton))
+				input = InputStand;
+			else if (CheckCollisionPointRec(mousePos, betButton))
+				input = InputBetUp;
+			else if (CheckCollisionPointRec(mousePos, doubleButton))
+				input = InputDouble;
+			else if (CheckCollisionPointRec(mousePos, splitButton))
+				input = InputSplit;
+			else if (CheckCollisionPointRec(mousePos, resetButton))
+				input = InputReset;
+		}
+		else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
+		{
+			if (CheckCollisionPointRec(mousePos, betButton))
+				input = InputBetDown;
+		}
+		if (IsKeyPressed(KEY_F3))
+		{
+			showProfiler = !showProfiler;
+			redraw = true;
+		}
+		if (IsKeyPressed(KEY_F4))
+		{
+			profiler.ExportTrace("trace.json");
+		}
+		if (IsKeyPressed(KEY_F5))
+		{
+			cardAtlas->Export("atlas.png");
+		}
+		if (IsKeyPressed(KEY_F6))
+		{
+			eventDriven = !eventDriven;
+			redraw = true;
+		}
+		profiler.End();
 
-		// Status
-		char statusText[32];
-		switch (globalGame->GetState())
+		// Send the click, and take the newest table
+		profiler.Begin("Update");
+		// Only reset goes through while cards are still flying, the player has not seen them yet
+		if (animation.IsBusy() && input != InputReset)
+		{
+			input = InputNone;
+		}
+		if (input != InputNone && logic->Push(input))
+		{
+			sent++;
+		}
+		// A hands the table to the basic strategy and takes it back
+		if (IsKeyPressed(KEY_A) && logic->Push(InputAutoplay))
+		{
+			sent++;
+		}
+		const TableSnapshot& table = logic->Acquire();
+		// The strategy plays far too fast to animate, its table is shown as it is sampled
+		bool autoplay = table.autoplay.enabled;
+		animation.Advance(GetTime());
+		if (!autoplay)
 		{
-		case Waiting:
-			sprintf_s(statusText, "Waiting...");
-			gameEnd = true;
-			break;
-		case Active:
-			sprintf_s(statusText, "Your Turn");
-			gameEnd = false;
-			break;
-		case Win:
-			sprintf_s(statusText, "You Win!");
-			gameEnd = true;
-			break;
-		case Lose:
-			sprintf_s(statusText, "You Lose!");
-			gameEnd = true;
-			break;
-		case Push:
-			sprintf_s(statusText, "Push - Draw!");
-			gameEnd = true;
-			break;
-		case GameOver:
-			sprintf_s(statusText, "Game Over!");
-			gameEnd = true;
-			break;
+			animation.Observe(table);
 		}
+		if (animation.TakeTick())
+		{
+			PlaySound(globalSounds->Tick);
+		}
+		if (table.clicks != clicksPlayed)
+		{
+			PlaySound(globalSounds->Click);
+			clicksPlayed = table.clicks;
+		}
+		bool gameEnd = table.gameEnd;
+		const char* statusText = autoplay ? "Autoplay" : animation.IsBusy() ? "Dealing..." : table.statusText;
+		CardView house = table.GetDealer();
+		profiler.End();
 
-		// Animation to draw the cards on-screen
-		if (time >= nextAnimTime)
+		// Idle frames are skipped, the overlay, animations and autoplay panel change every frame so they are always drawn
+		if (eventDriven && !showProfiler && !autoplay && !animation.IsBusy() && !redraw && !staticDirty && !IsWindowResized() && table.version == drawnVersion)
 		{
-			if (!dealerDealt)
+			framesSkipped++;
+			if (table.applied == sent)
 			{
-				globalGame->Deal(false);
-				// Play a sound
-				PlaySound(globalSounds->Tick);
-				// Stop dealing after two cards have been dealt
-				if (house.size() == 1)
-				{
-					dealerDealt = true;
-				}
-				nextAnimTime += nextAnimTimeInterval;
+				// Nothing will happen until there is input
+				EnableEventWaiting();
+				PollInputEvents();
+				DisableEventWaiting();
 			}
-			else if (!playerDealt)
+			else
 			{
-				globalGame->GetPlayer()->AddCard(globalGame->PickCard());
-				PlaySound(globalSounds->Tick);
-				playerDealt = true;
+				// A click is on its way, check again next frame
+				WaitTime(1.0 / 60.0);
+				PollInputEvents();
 			}
+			continue;
 		}
+		redraw = false;
+		drawnVersion = table.version;
+		framesRendered++;
 
-		// Detect button click
-		Vector2 mousePos = GetMousePosition();
-		if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+		// The static layer is drawn once and again only when the window changes size
+		if (IsWindowResized())
 		{
-			if (CheckCollisionPointRec(mousePos, hitButton) && !gameEnd)
-			{
-				// Play a sound
-				PlaySound(globalSounds->Click);
-				// Hit
-				globalGame->Hit();
-				dealerRevealed = true;
-			}
-			else if (CheckCollisionPointRec(mousePos, standButton) && !gameEnd)
-			{
-				// Play a sound
-				PlaySound(globalSounds->Click);
-				// Stand
-				globalGame->Stand();
-				dealerRevealed = true;
-			}
-			else if (CheckCollisionPointRec(mousePos, betButton) && !gameEnd)
-			{
-				// Play a sound
-				PlaySound(globalSounds->Click);
-				// Bet
-				globalGame->GetPlayer()->SetBet(globalGame->GetPlayer()->GetBet() + 10);
-			}
-			else if (CheckCollisionPointRec(mousePos, resetButton))
-			{
-				// Play a sound
-				PlaySound(globalSounds->Click);
-				// Reset game
-				globalGame->Start();
-				dealerDealt = false;
-				playerDealt = false;
-				startTime = GetTime();
-				nextAnimTime = 0;
-				dealerRevealed = false;
-			}
+			UnloadRenderTexture(staticLayer);
+			staticLayer = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+			staticDirty = true;
 		}
-		else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
+		if (staticDirty)
 		{
-			if (CheckCollisionPointRec(mousePos, betButton) && !gameEnd)
-			{
-				// Play a sound
-				PlaySound(globalSounds->Click);
-				// Bet
-				globalGame->GetPlayer()->SetBet(globalGame->GetPlayer()->GetBet() - 10);
-			}
+			profiler.Begin("Static");
+			BeginTextureMode(staticLayer);
+			ClearBackground(DARKGRAY);
+
+			DrawText("House", 12, 12, 20, BLACK);
+			DrawText("House", 10, 10, 20, WHITE);
+			DrawText("Your Hand", 12, 162, 20, BLACK);
+			DrawText("Your Hand", 10, 160, 20, WHITE);
+
+			// Hit
+			DrawRectangleRounded(hitButtonShadow, 0.2f, 10, BLACK);
+			DrawRectangleRounded(hitButton, 0.2f, 10, GRAY);
+			DrawText("Hit", 12, 302, 20, BLACK);
+			DrawText("Hit", 10, 300, 20, WHITE);
+
+			// Stand
+			DrawRectangleRounded(standButtonShadow, 0.2f, 10, BLACK);
+			DrawRectangleRounded(standButton, 0.2f, 10, GRAY);
+			DrawText("Stand", 142, 302, 20, BLACK);
+			DrawText("Stand", 140, 300, 20, WHITE);
+
+			// Bet
+			DrawRectangleRounded(betButtonShadow, 0.2f, 10, BLACK);
+			DrawRectangleRounded(betButton, 0.2f, 10, GRAY);
+			DrawText("Bet", 272, 302, 20, BLACK);
+			DrawText("Bet", 270, 300, 20, WHITE);
+
+			// Reset
+			DrawRectangleRounded(resetButtonShadow, 0.2f, 10, BLACK);
+			DrawRectangleRounded(resetButton, 0.2f, 10, GRAY);
+			DrawText("Reset", 402, 302, 20, BLACK);
+			DrawText("Reset", 400, 300, 20, WHITE);
+
+			// Double
+			DrawRectangleRounded(doubleButtonShadow, 0.2f, 10, BLACK);
+			DrawRectangleRounded(doubleButton, 0.2f, 10, GRAY);
+			DrawText("Double", 532, 302, 20, BLACK);
+			DrawText("Double", 530, 300, 20, WHITE);
+
+			// Split
+			DrawRectangleRounded(splitButtonShadow, 0.2f, 10, BLACK);
+			DrawRectangleRounded(splitButton, 0.2f, 10, GRAY);
+			DrawText("Split", 662, 302, 20, BLACK);
+			DrawText("Split", 660, 300, 20, WHITE);
+
+			// Center: raylib-stuff: Blackjack
+			DrawText("raylib-stuff: Blackjack", 280, 382, 20, BLACK);
+			DrawText("raylib-stuff: Blackjack", 278, 380, 20, WHITE);
+		
+			// Center: by KiwifruitDev
+			DrawText("by KiwifruitDev", 320, 412, 20, BLACK);
+			DrawText("by KiwifruitDev", 318, 410, 20, WHITE);
+
+			EndTextureMode();
+			staticDirty = false;
+			profiler.End();
 		}
 
         // Draw //
@@ -226,80 +365,131 @@ int main(void)
 
         ClearBackground(DARKGRAY);
 
+		// Render textures are stored upside down
+		DrawTextureRec(staticLayer.texture, { 0.0f, 0.0f, (float)staticLayer.texture.width, (float)-staticLayer.texture.height }, { 0.0f, 0.0f }, WHITE);
+
         // Dealer's cards
+		profiler.Begin("Cards");
+		profiler.Begin("Dealer");
 		for (int i = 0; i < house.size(); i++)
 		{
-            DrawRectangleRounded({ 12.0f + (i * 70.0f), 52.0f, 60.0f, 90.0f }, 0.2f, 10, BLACK);
-			DrawRectangleRounded({ 10.0f + (i * 70.0f), 50.0f, 60.0f, 90.0f }, 0.2f, 10, LIGHTGRAY);
-			if (!dealerRevealed && i > 0)
+			float dealt = autoplay ? 1.0f : animation.GetDealer(i);
+			if (dealt < 0.0f)
 			{
-				break;
+				continue;
 			}
-			DrawCard(house[i], i, 50.0f);
+			float x = shoe.x + ((10.0f + (i * 70.0f)) - shoe.x) * dealt;
+			float y = shoe.y + (50.0f - shoe.y) * dealt;
+			// The hole card turns over edge on, back first
+			float reveal = i != 1 ? 1.0f : autoplay ? (table.dealerRevealed ? 1.0f : 0.0f) : animation.GetReveal();
+			if (reveal < 0.5f)
+			{
+				cardAtlas->DrawBack(x, y, 1.0f - reveal * 2.0f);
+			}
+			else
+			{
+				cardAtlas->Draw(house[i], x, y, reveal * 2.0f - 1.0f);
+			}
+		}
+		profiler.End();
+
+        // Player's cards, split hands are fanned side by side
+		profiler.Begin("Player");
+		float handX = 10.0f;
+		float spacing = table.handCount > 1 ? 25.0f : 70.0f;
+		for (int h = 0; h < table.handCount; h++)
+		{
+			CardView cards = table.GetHand(h);
+			// Outline the hand being played
+			if (table.handCount > 1 && h == table.active && !gameEnd)
+			{
+				DrawRectangleRounded({ handX - 4.0f, 196.0f, 68.0f + ((cards.size() - 1) * spacing), 98.0f }, 0.2f, 10, GOLD);
+			}
+			for (int i = 0; i < cards.size(); i++)
+			{
+				float dealt = autoplay ? 1.0f : animation.GetHand(h, i);
+				if (dealt >= 0.0f)
+				{
+					cardAtlas->Draw(cards[i], shoe.x + ((handX + (i * spacing)) - shoe.x) * dealt, shoe.y + (200.0f - shoe.y) * dealt);
+				}
+			}
+			handX += 80.0f + ((cards.size() - 1) * spacing);
 		}
-		DrawText("House", 12, 12, 20, BLACK);
-        DrawText("House", 10, 10, 20, WHITE);
+		profiler.End();
 
-        // Player's cards
-		for (int i = 0; i < playerHand.size(); i++)
+		// The bet's chip goes to whoever won it
+		int chipDirection = 0;
+		float chip = animation.GetChip(chipDirection);
+		if (chip >= 0.0f && !autoplay)
 		{
-            DrawRectangleRounded({ 12.0f + (i * 70.0f), 202.0f, 60.0f, 90.0f }, 0.2f, 10, BLACK);
-			DrawRectangleRounded({ 10.0f + (i * 70.0f), 200.0f, 60.0f, 90.0f }, 0.2f, 10, LIGHTGRAY);
-			DrawCard(playerHand[i], i, 200.0f);
+			Vector2 to = chipDirection > 0 ? Vector2{ 150.0f, 390.0f } : Vector2{ 40.0f, 20.0f };
+			int x = (int)(120.0f + (to.x - 120.0f) * chip);
+			int y = (int)(360.0f + (to.y - 360.0f) * chip);
+			DrawCircle(x + 2, y + 2, 12.0f, BLACK);
+			DrawCircle(x, y, 12.0f, GOLD);
+		}
+		profiler.End();
+
+		// Actions the game would refuse are dimmed over the static buttons
+		profiler.Begin("UI");
+		ActionSet legal = table.legal;
+		if (!(legal & ActionBit(DOUBLE)))
+		{
+			DrawRectangleRounded(doubleButton, 0.2f, 10, DARKGRAY);
+			DrawText("Double", 532, 302, 20, BLACK);
+			DrawText("Double", 530, 300, 20, WHITE);
+		}
+		if (!(legal & ActionBit(SPLIT)))
+		{
+			DrawRectangleRounded(splitButton, 0.2f, 10, DARKGRAY);
+			DrawText("Split", 662, 302, 20, BLACK);
+			DrawText("Split", 660, 300, 20, WHITE);
 		}
-		DrawText("Your Hand", 12, 162, 20, BLACK);
-		DrawText("Your Hand", 10, 160, 20, WHITE);
-
-		// Hit
-		DrawRectangleRounded(hitButtonShadow, 0.2f, 10, BLACK);
-		DrawRectangleRounded(hitButton, 0.2f, 10, GRAY);
-		DrawText("Hit", 12, 302, 20, BLACK);
-		DrawText("Hit", 10, 300, 20, WHITE);
-
-		// Stand
-		DrawRectangleRounded(standButtonShadow, 0.2f, 10, BLACK);
-		DrawRectangleRounded(standButton, 0.2f, 10, GRAY);
-		DrawText("Stand", 142, 302, 20, BLACK);
-		DrawText("Stand", 140, 300, 20, WHITE);
-
-		// Bet
-		DrawRectangleRounded(betButtonShadow, 0.2f, 10, BLACK);
-		DrawRectangleRounded(betButton, 0.2f, 10, GRAY);
-		DrawText("Bet", 272, 302, 20, BLACK);
-		DrawText("Bet", 270, 300, 20, WHITE);
-
-		// Reset
-		DrawRectangleRounded(resetButtonShadow, 0.2f, 10, BLACK);
-		DrawRectangleRounded(resetButton, 0.2f, 10, GRAY);
-		DrawText("Reset", 402, 302, 20, BLACK);
-		DrawText("Reset", 400, 300, 20, WHITE);
 
 		// Player's bet
 		char betText[32];
-		sprintf_s(betText, "Bet: %d", globalGame->GetPlayer()->GetBet());
+		Money bet = table.bet;
+		sprintf_s(betText, "Bet: %lld.%02lld", (long long)bet.GetUnits(), (long long)llabs(bet.GetCents()));
 		DrawText(betText, 12, 352, 20, BLACK);
 		DrawText(betText, 10, 350, 20, WHITE);
 
 		// Player's money
 		char moneyText[32];
-		sprintf_s(moneyText, "Money: %d", globalGame->GetPlayer()->GetBalance());
+		Money balance = table.balance;
+		sprintf_s(moneyText, "Money: %lld.%02lld", (long long)balance.GetUnits(), (long long)llabs(balance.GetCents()));
 		DrawText(moneyText, 12, 382, 20, BLACK);
 		DrawText(moneyText, 10, 380, 20, WHITE);
 
 		DrawText(statusText, 12, 412, 20, BLACK);
 		DrawText(statusText, 10, 410, 20, WHITE);
+		profiler.End();
 
-		// Center: raylib-stuff: Blackjack
-		DrawText("raylib-stuff: Blackjack", 280, 382, 20, BLACK);
-		DrawText("raylib-stuff: Blackjack", 278, 380, 20, WHITE);
-		
-		// Center: by KiwifruitDev
-		DrawText("by KiwifruitDev", 320, 412, 20, BLACK);
-		DrawText("by KiwifruitDev", 318, 410, 20, WHITE);
+		if (autoplay)
+		{
+			DrawAutoplay(table.autoplay, showProfiler ? screenWidth - 520 : screenWidth - 260, 10);
+		}
+
+		if (showProfiler)
+		{
+			profiler.Begin("Overlay");
+			DrawProfiler(profiler, screenWidth - 260, 10, framesRendered, framesSkipped);
+			profiler.End();
+		}
 
+		// Swapping buffers also waits out the frame
+		profiler.Begin("Present");
         EndDrawing();
+		profiler.End();
     }
 
+	delete logic;
+	delete cardAtlas;
+	UnloadRenderTexture(staticLayer);
+	delete globalSounds;
+	globalGame->SetHistory(nullptr);
+	delete history;
+	delete globalGame;
+
 	CloseAudioDevice();
     CloseWindow();
     return 0;
@@ -0,0 +1,341 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "dealer.hpp"
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Mixes the bits of a number, the SplitMix64 finalizer.
+/// </summary>
+static uint64_t Mix(uint64_t z)
+{
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+/// <summary>
+/// Gets a hand's score from its hard score, counting an ace as 11 if that does not bust.
+/// </summary>
+static int Score(int hard, bool ace)
+{
+	return hard + (ace && hard <= 11 ? 10 : 0);
+}
+
+/// <summary>
+/// Creates the composition of full decks.
+/// </summary>
+/// <param name="decks">The number of decks.</param>
+/// <returns>The composition.</returns>
+Composition Composition::Full(int decks)
+{
+	Composition composition;
+	for (int i = 0; i < 9; i++)
+	{
+		composition.counts[i] = decks * 4;
+	}
+	// Tens, jacks, queens and kings
+	composition.counts[9] = decks * 16;
+	composition.total = decks * 52;
+	return composition;
+}
+
+/// <summary>
+/// Creates the composition of the cards left in a shoe.
+/// </summary>
+/// <param name="shoe">The shoe.</param>
+/// <returns>The composition.</returns>
+Composition Composition::FromShoe(Shoe& shoe)
+{
+	Composition composition = Composition();
+	for (int i = 0; i < 13; i++)
+	{
+		composition.counts[CardPoints[i] - 1] += shoe.GetRemaining((CardValue)i);
+	}
+	composition.total = shoe.GetRemaining();
+	return composition;
+}
+
+/// <summary>
+/// Hashes the composition.
+/// </summary>
+/// <returns>The hash.</returns>
+uint64_t Composition::Hash() const
+{
+	// Every count fits in a byte, even with 8 decks.
+	uint64_t low = 0;
+	for (int i = 0; i < 8; i++)
+	{
+		low |= (uint64_t)(counts[i] & 0xFF) << (i * 8);
+	}
+	uint64_t high = (uint64_t)(counts[8] & 0xFF) | (uint64_t)(counts[9] & 0xFF) << 8;
+	return Mix(low ^ Mix(high));
+}
+
+bool Composition::operator==(const Composition& other) const
+{
+	for (int i = 0; i < 10; i++)
+	{
+		if (counts[i] != other.counts[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// Constructor.
+/// </summary>
+/// <param name="maxEntries">The cache is cleared once it holds this many entries.</param>
+/// <param name="peek">The dealer checks for blackjack before the player acts, every result assumes it did not have one.</param>
+DealerOdds::DealerOdds(size_t maxEntries, bool peek) : lookups(), hits(), maxEntries(maxEntries), peek(peek) {}
+
+/// <summary>
+/// The dealer's outcome from a hand, drawing from a composition.
+/// </summary>
+/// <param name="hard">The dealer's hard score.</param>
+/// <param name="ace">Whether the dealer holds an ace.</param>
+/// <param name="composition">The cards left, restored before returning.</param>
+DealerOutcome DealerOdds::Dealer(int hard, bool ace, Composition& composition)
+{
+	DealerOutcome outcome = DealerOutcome();
+
+	// The dealer stands on 17, and an exhausted shoe ends the hand too (counted as 17).
+	int score = Score(hard, ace);
+	if (score >= 17 || composition.total == 0)
+	{
+		outcome.totals[score > 21 ? 5 : score < 17 ? 0 : score - 17] = 1.0;
+		return outcome;
+	}
+
+	// Look in the cache
+	uint64_t key = Mix(composition.Hash() ^ (uint64_t)(hard << 1 | ace));
+	lookups++;
+	auto found = dealerCache.find(key);
+	if (found != dealerCache.end() && found->second.hard == hard && found->second.ace == ace && found->second.composition == composition)
+	{
+		hits++;
+		return found->second.outcome;
+	}
+
+	// Draw every possible card
+	for (int points = 1; points <= 10; points++)
+	{
+		int count = composition.counts[points - 1];
+		if (count == 0)
+		{
+			continue;
+		}
+		double chance = (double)count / composition.total;
+		composition.Remove(points);
+		DealerOutcome next = Dealer(hard + points, ace || points == 1, composition);
+		composition.Add(points);
+		for (int i = 0; i < 6; i++)
+		{
+			outcome.totals[i] += chance * next.totals[i];
+		}
+	}
+
+	if (dealerCache.size() + playerCache.size() >= maxEntries)
+	{
+		Clear();
+	}
+	dealerCache[key] = DealerEntry{ composition, hard, ace, outcome };
+	return outcome;
+}
+
+/// <summary>
+/// The player's expected value of playing on optimally, hitting or standing.
+/// </summary>
+/// <param name="hard">The player's hard score.</param>
+/// <param name="ace">Whether the player holds an ace.</param>
+/// <param name="upcard">The dealer's upcard points, 1 for aces.</param>
+/// <param name="composition">The cards left, restored before returning.</param>
+double DealerOdds::Best(int hard, bool ace, int upcard, Composition& composition)
+{
+	if (hard > 21)
+	{
+		return -1.0;
+	}
+
+	int score = Score(hard, ace);
+	double stand = GetStandEV(score, upcard, composition);
+	if (score == 21 || composition.total == 0)
+	{
+		return stand;
+	}
+
+	// Look in the cache
+	uint64_t key = Mix(composition.Hash() ^ (uint64_t)(upcard << 6 | hard << 1 | ace) << 32);
+	lookups++;
+	auto found = playerCache.find(key);
+	if (found != playerCache.end() && found->second.hard == hard && found->second.ace == ace
+		&& found->second.upcard == upcard && found->second.composition == composition)
+	{
+		hits++;
+		return found->second.ev;
+	}
+
+	double hit = GetHitEV(hard, ace, upcard, composition);
+	double ev = hit > stand ? hit : stand;
+
+	if (dealerCache.size() + playerCache.size() >= maxEntries)
+	{
+		Clear();
+	}
+	playerCache[key] = PlayerEntry{ composition, hard, ace, upcard, ev };
+	return ev;
+}
+
+/// <summary>
+/// Gets the dealer's final total distribution for an upcard.
+/// <para>The hole card is drawn from the composition like every other card, unless it would complete a blackjack the dealer has peeked for.</para>
+/// </summary>
+/// <param name="upcard">The upcard points, 1 for aces.</param>
+/// <param name="composition">The cards left, not including the upcard.</param>
+/// <returns>The outcome.</returns>
+DealerOutcome DealerOdds::GetOutcome(int upcard, const Composition& composition)
+{
+	Composition cards = composition;
+	if (!peek || (upcard != 1 && upcard != 10))
+	{
+		return Dealer(upcard, upcard == 1, cards);
+	}
+
+	// Draw the hole card here, leaving out the card that makes a blackjack.
+	int natural = upcard == 1 ? 10 : 1;
+	int total = cards.total - cards.counts[natural - 1];
+	DealerOutcome outcome = DealerOutcome();
+	for (int points = 1; points <= 10; points++)
+	{
+		int count = cards.counts[points - 1];
+		if (points == natural || count == 0)
+		{
+			continue;
+		}
+		double chance = (double)count / total;
+		cards.Remove(points);
+		DealerOutcome next = Dealer(upcard + points, upcard == 1 || points == 1, cards);
+		cards.Add(points);
+		for (int i = 0; i < 6; i++)
+		{
+			outcome.totals[i] += chance * next.totals[i];
+		}
+	}
+	return outcome;
+}
+
+/// <summary>
+/// Gets the expected value of standing, in units of the bet.
+/// </summary>
+/// <param name="score">The player's score.</param>
+/// <param name="upcard">The dealer's upcard points, 1 for aces.</param>
+/// <param name="composition">The cards left, not including the upcard or the player's cards.</param>
+/// <returns>The expected value.</returns>
+double DealerOdds::GetStandEV(int score, int upcard, const Composition& composition)
+{
+	if (score > 21)
+	{
+		return -1.0;
+	}
+
+	DealerOutcome outcome = GetOutcome(upcard, composition);
+	double ev = outcome.GetBust();
+	for (int total = 17; total <= 21; total++)
+	{
+		if (score > total)
+		{
+			ev += outcome.Get(total);
+		}
+		else if (score < total)
+		{
+			ev -= outcome.Get(total);
+		}
+	}
+	return ev;
+}
+
+/// <summary>
+/// Gets the expected value of hitting once and then playing on optimally, in units of the bet.
+/// </summary>
+/// <param name="hard">The player's hard score.</param>
+/// <param name="ace">Whether the player holds an ace.</param>
+/// <param name="upcard">The dealer's upcard points, 1 for aces.</param>
+/// <param name="composition">The cards left, not including the upcard or the player's cards.</param>
+/// <returns>The expected value.</returns>
+double DealerOdds::GetHitEV(int hard, bool ace, int upcard, const Composition& composition)
+{
+	Composition cards = composition;
+	double ev = 0.0;
+	for (int points = 1; points <= 10; points++)
+	{
+		int count = cards.counts[points - 1];
+		if (count == 0)
+		{
+			continue;
+		}
+		double chance = (double)count / cards.total;
+		cards.Remove(points);
+		ev += chance * Best(hard + points, ace || points == 1, upcard, cards);
+		cards.Add(points);
+	}
+	return ev;
+}
+
+/// <summary>
+/// Gets whether the dealer has peeked for blackjack.
+/// </summary>
+bool DealerOdds::GetPeek()
+{
+	return peek;
+}
+
+/// <summary>
+/// Gets the number of cache lookups made.
+/// </summary>
+long long DealerOdds::GetLookups()
+{
+	return lookups;
+}
+
+/// <summary>
+/// Gets the number of cache lookups that found a result.
+/// </summary>
+long long DealerOdds::GetHits()
+{
+	return hits;
+}
+
+/// <summary>
+/// Empties the cache.
+/// </summary>
+void DealerOdds::Clear()
+{
+	dealerCache.clear();
+	playerCache.clear();
+}
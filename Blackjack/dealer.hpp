@@ -0,0 +1,256 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "shoe.hpp"
+#include <cstdint>
+#include <unordered_map>
+
+// Exact dealer and player odds
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// The cards left in a shoe, counted by points.
+		/// <para>Index 0 holds aces, index 9 holds every card worth 10.</para>
+		/// </summary>
+		struct Composition
+		{
+			/// <summary>
+			/// The number of cards of each point value.
+			/// </summary>
+			int counts[10];
+
+			/// <summary>
+			/// The total number of cards.
+			/// </summary>
+			int total;
+
+			/// <summary>
+			/// Creates the composition of full decks.
+			/// </summary>
+			/// <param name="decks">The number of decks.</param>
+			/// <returns>The composition.</returns>
+			static Composition Full(int decks);
+
+			/// <summary>
+			/// Creates the composition of the cards left in a shoe.
+			/// </summary>
+			/// <param name="shoe">The shoe.</param>
+			/// <returns>The composition.</returns>
+			static Composition FromShoe(Shoe& shoe);
+
+			/// <summary>
+			/// Removes a card.
+			/// </summary>
+			/// <param name="points">The card's points, 1 for aces.</param>
+			void Remove(int points)
+			{
+				counts[points - 1]--;
+				total--;
+			}
+
+			/// <summary>
+			/// Puts a card back.
+			/// </summary>
+			/// <param name="points">The card's points, 1 for aces.</param>
+			void Add(int points)
+			{
+				counts[points - 1]++;
+				total++;
+			}
+
+			/// <summary>
+			/// Hashes the composition.
+			/// </summary>
+			/// <returns>The hash.</returns>
+			uint64_t Hash() const;
+
+			bool operator==(const Composition& other) const;
+		};
+
+		/// <summary>
+		/// Where the dealer's hand ends up.
+		/// </summary>
+		struct DealerOutcome
+		{
+			/// <summary>
+			/// The chance of ending on 17, 18, 19, 20 and 21, followed by the chance of busting.
+			/// </summary>
+			double totals[6];
+
+			/// <summary>
+			/// Gets the chance of busting.
+			/// </summary>
+			double GetBust() const
+			{
+				return totals[5];
+			}
+
+			/// <summary>
+			/// Gets the chance of ending on a total.
+			/// </summary>
+			/// <param name="total">The total, 17 to 21.</param>
+			double Get(int total) const
+			{
+				return totals[total - 17];
+			}
+		};
+
+		/// <summary>
+		/// Computes exact odds for the dealer drawing to 17 from a known composition.
+		/// <para>Every result is cached under a hash of the composition, so a repeated query is a single lookup.</para>
+		/// </summary>
+		class DealerOdds
+		{
+		private:
+			/// <summary>
+			/// A cached dealer state.
+			/// <para>The composition is kept to tell hash collisions apart.</para>
+			/// </summary>
+			struct DealerEntry
+			{
+				Composition composition;
+				int hard;
+				bool ace;
+				DealerOutcome outcome;
+			};
+
+			/// <summary>
+			/// A cached player decision.
+			/// </summary>
+			struct PlayerEntry
+			{
+				Composition composition;
+				int hard;
+				bool ace;
+				int upcard;
+				double ev;
+			};
+
+			/// <summary>
+			/// Dealer states by hash.
+			/// </summary>
+			std::unordered_map<uint64_t, DealerEntry> dealerCache;
+
+			/// <summary>
+			/// Best player expected values by hash.
+			/// </summary>
+			std::unordered_map<uint64_t, PlayerEntry> playerCache;
+
+			/// <summary>
+			/// Cache lookups and how many of them were found.
+			/// </summary>
+			long long lookups;
+			long long hits;
+
+			/// <summary>
+			/// The cache is cleared once it holds this many entries.
+			/// </summary>
+			size_t maxEntries;
+
+			/// <summary>
+			/// The dealer has checked for blackjack, so an ace or ten upcard never completes one.
+			/// </summary>
+			bool peek;
+
+			/// <summary>
+			/// The dealer's outcome from a hand, drawing from a composition.
+			/// </summary>
+			/// <param name="hard">The dealer's hard score.</param>
+			/// <param name="ace">Whether the dealer holds an ace.</param>
+			/// <param name="composition">The cards left, restored before returning.</param>
+			DealerOutcome Dealer(int hard, bool ace, Composition& composition);
+
+			/// <summary>
+			/// The player's expected value of playing on optimally, hitting or standing.
+			/// </summary>
+			/// <param name="hard">The player's hard score.</param>
+			/// <param name="ace">Whether the player holds an ace.</param>
+			/// <param name="upcard">The dealer's upcard points, 1 for aces.</param>
+			/// <param name="composition">The cards left, restored before returning.</param>
+			double Best(int hard, bool ace, int upcard, Composition& composition);
+		public:
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			/// <param name="maxEntries">The cache is cleared once it holds this many entries.</param>
+			/// <param name="peek">The dealer checks for blackjack before the player acts, every result assumes it did not have one.</param>
+			DealerOdds(size_t maxEntries = 1 << 22, bool peek = false);
+
+			/// <summary>
+			/// Gets the dealer's final total distribution for an upcard.
+			/// <para>The hole card is drawn from the composition like every other card, unless it would complete a blackjack the dealer has peeked for.</para>
+			/// </summary>
+			/// <param name="upcard">The upcard points, 1 for aces.</param>
+			/// <param name="composition">The cards left, not including the upcard.</param>
+			/// <returns>The outcome.</returns>
+			DealerOutcome GetOutcome(int upcard, const Composition& composition);
+
+			/// <summary>
+			/// Gets the expected value of standing, in units of the bet.
+			/// </summary>
+			/// <param name="score">The player's score.</param>
+			/// <param name="upcard">The dealer's upcard points, 1 for aces.</param>
+			/// <param name="composition">The cards left, not including the upcard or the player's cards.</param>
+			/// <returns>The expected value.</returns>
+			double GetStandEV(int score, int upcard, const Composition& composition);
+
+			/// <summary>
+			/// Gets the expected value of hitting once and then playing on optimally, in units of the bet.
+			/// </summary>
+			/// <param name="hard">The player's hard score.</param>
+			/// <param name="ace">Whether the player holds an ace.</param>
+			/// <param name="upcard">The dealer's upcard points, 1 for aces.</param>
+			/// <param name="composition">The cards left, not including the upcard or the player's cards.</param>
+			/// <returns>The expected value.</returns>
+			double GetHitEV(int hard, bool ace, int upcard, const Composition& composition);
+
+			/// <summary>
+			/// Gets whether the dealer has peeked for blackjack.
+			/// </summary>
+			bool GetPeek();
+
+			/// <summary>
+			/// Gets the number of cache lookups made.
+			/// </summary>
+			long long GetLookups();
+
+			/// <summary>
+			/// Gets the number of cache lookups that found a result.
+			/// </summary>
+			long long GetHits();
+
+			/// <summary>
+			/// Empties the cache.
+			/// </summary>
+			void Clear();
+		};
+	}
+}
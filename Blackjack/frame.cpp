@@ -0,0 +1,217 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "frame.hpp"
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Constructor, deals the opening cards.
+/// </summary>
+/// <param name="game">The game being shown, already started.</param>
+Frame::Frame(RuntimeGame* game) : game(game), gameEnd(true), statusText("Waiting..."), version(0), round(0)
+{
+	DealOpening();
+	UpdateStatus();
+}
+
+/// <summary>
+/// Sets the status line and button lock from the game's state.
+/// </summary>
+void Frame::UpdateStatus()
+{
+	switch (game->GetState())
+	{
+	case Waiting:
+		statusText = "Waiting...";
+		gameEnd = true;
+		break;
+	case Active:
+		statusText = "Your Turn";
+		gameEnd = false;
+		break;
+	case Win:
+		statusText = "You Win!";
+		gameEnd = true;
+		break;
+	case Lose:
+		statusText = "You Lose!";
+		gameEnd = true;
+		break;
+	case Push:
+		statusText = "Push - Draw!";
+		gameEnd = true;
+		break;
+	case GameOver:
+		statusText = "Game Over!";
+		gameEnd = true;
+		break;
+	}
+}
+
+/// <summary>
+/// Deals the dealer's two cards, then the player's.
+/// </summary>
+void Frame::DealOpening()
+{
+	round++;
+	while (game->GetHand()->GetCount() < 2)
+	{
+		game->Deal(false);
+	}
+	// A natural settles the round as the second card lands
+	while (game->GetState() == GameState::Waiting && game->GetPlayer()->GetHand(0)->GetCount() < 2)
+	{
+		game->DealPlayer();
+	}
+}
+
+/// <summary>
+/// Runs one frame of game logic.
+/// </summary>
+/// <param name="input">The button pressed this frame.</param>
+/// <returns>The <see cref="FrameSound"/> bits to play.</returns>
+int Frame::Update(FrameInput input)
+{
+	int sounds = FrameSilent;
+	const char* lastStatus = statusText;
+
+	// Buttons, only reset works outside the player's turn
+	Player* player = game->GetPlayer();
+	switch (input)
+	{
+	case InputHit:
+		if (!gameEnd)
+		{
+			sounds |= FrameClick;
+			game->Hit();
+		}
+		break;
+	case InputStand:
+		if (!gameEnd)
+		{
+			sounds |= FrameClick;
+			game->Stand();
+		}
+		break;
+	case InputBetUp:
+		// Raise the bet, if the balance covers it
+		if (!gameEnd && player->SetBet(player->GetBet() + Money::FromUnits(10)))
+		{
+			sounds |= FrameClick;
+		}
+		break;
+	case InputBetDown:
+		// Lower the bet, if it stays above nothing
+		if (!gameEnd && player->SetBet(player->GetBet() - Money::FromUnits(10)))
+		{
+			sounds |= FrameClick;
+		}
+		break;
+	case InputDouble:
+		// Double, if allowed
+		if (!gameEnd && game->Double())
+		{
+			sounds |= FrameClick;
+		}
+		break;
+	case InputSplit:
+		// Split, if allowed
+		if (!gameEnd && game->Split())
+		{
+			sounds |= FrameClick;
+		}
+		break;
+	case InputSurrender:
+		// Surrender, if allowed
+		if (!gameEnd && game->Surrender())
+		{
+			sounds |= FrameClick;
+		}
+		break;
+	case InputReset:
+		sounds |= FrameClick;
+		game->Start();
+		DealOpening();
+		break;
+	default:
+		break;
+	}
+
+	// Show what this frame's deals and buttons did
+	UpdateStatus();
+	if (sounds != FrameSilent || statusText != lastStatus)
+	{
+		version++;
+	}
+
+	return sounds;
+}
+
+/// <summary>
+/// Gets the status line.
+/// </summary>
+/// <returns>The status line.</returns>
+const char* Frame::GetStatusText()
+{
+	return statusText;
+}
+
+/// <summary>
+/// Checks if the dealer's hole card is shown.
+/// </summary>
+/// <returns>True if every dealer card is shown.</returns>
+bool Frame::IsDealerRevealed()
+{
+	return game->GetState() != GameState::Active;
+}
+
+/// <summary>
+/// Checks if the buttons are locked.
+/// </summary>
+/// <returns>True if it is not the player's turn.</returns>
+bool Frame::IsGameEnd()
+{
+	return gameEnd;
+}
+
+/// <summary>
+/// Gets a counter that changes whenever anything shown changes, a frame with the same version as the last one drawn need not be drawn.
+/// </summary>
+/// <returns>The version.</returns>
+uint32_t Frame::GetVersion()
+{
+	return version;
+}
+
+/// <summary>
+/// Gets how many rounds have been dealt, so the window can tell a new round from the last one.
+/// </summary>
+/// <returns>The round number, from 1.</returns>
+uint32_t Frame::GetRound()
+{
+	return round;
+}
@@ -0,0 +1,149 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "game.hpp"
+
+// Per-frame window logic, kept apart from raylib so it can be run and measured without a window
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// What the player did this frame, one button at most.
+		/// </summary>
+		enum FrameInput
+		{
+			InputNone,
+			InputHit,
+			InputStand,
+			InputBetUp,
+			InputBetDown,
+			InputDouble,
+			InputSplit,
+			InputSurrender,
+			InputReset,
+			InputAutoplay
+		};
+
+		/// <summary>
+		/// Sounds to play after a frame, as bits.
+		/// </summary>
+		enum FrameSound
+		{
+			FrameSilent = 0,
+			FrameClick = 2
+		};
+
+		/// <summary>
+		/// The window's game logic: dealing, the status and the buttons.
+		/// <para>Cards are dealt at once, showing them being dealt is left to the window.</para>
+		/// </summary>
+		class Frame
+		{
+		private:
+			/// <summary>
+			/// The game being shown.
+			/// </summary>
+			RuntimeGame* game;
+
+			/// <summary>
+			/// Whether the buttons are locked because it is not the player's turn.
+			/// </summary>
+			bool gameEnd;
+
+			/// <summary>
+			/// The status line.
+			/// </summary>
+			const char* statusText;
+
+			/// <summary>
+			/// Bumped whenever anything shown changes.
+			/// </summary>
+			uint32_t version;
+
+			/// <summary>
+			/// Rounds dealt so far.
+			/// </summary>
+			uint32_t round;
+
+			/// <summary>
+			/// Sets the status line and button lock from the game's state.
+			/// </summary>
+			void UpdateStatus();
+
+			/// <summary>
+			/// Deals the dealer's two cards, then the player's.
+			/// </summary>
+			void DealOpening();
+		public:
+			/// <summary>
+			/// Constructor, deals the opening cards.
+			/// </summary>
+			/// <param name="game">The game being shown, already started.</param>
+			Frame(RuntimeGame* game);
+
+			/// <summary>
+			/// Runs one frame of game logic.
+			/// </summary>
+			/// <param name="input">The button pressed this frame.</param>
+			/// <returns>The <see cref="FrameSound"/> bits to play.</returns>
+			int Update(FrameInput input);
+
+			/// <summary>
+			/// Gets the status line.
+			/// </summary>
+			/// <returns>The status line.</returns>
+			const char* GetStatusText();
+
+			/// <summary>
+			/// Checks if the dealer's hole card is shown.
+			/// </summary>
+			/// <returns>True if every dealer card is shown.</returns>
+			bool IsDealerRevealed();
+
+			/// <summary>
+			/// Checks if the buttons are locked.
+			/// </summary>
+			/// <returns>True if it is not the player's turn.</returns>
+			bool IsGameEnd();
+
+			/// <summary>
+			/// Gets a counter that changes whenever anything shown changes, a frame with the same version as the last one drawn need not be drawn.
+			/// </summary>
+			/// <returns>The version.</returns>
+			uint32_t GetVersion();
+
+			/// <summary>
+			/// Gets how many rounds have been dealt, so the window can tell a new round from the last one.
+			/// </summary>
+			/// <returns>The round number, from 1.</returns>
+			uint32_t GetRound();
+		};
+	}
+}
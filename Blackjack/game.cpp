@@ -25,63 +25,126 @@
 */
 
 #include "game.hpp"
+#include "history.hpp"
+#include <algorithm>
 #include <iostream>
 
 using namespace KiwifruitDev::Blackjack;
 
 /// <summary>
-/// Constructor.
+/// Constructor, seeded from the system's random device.
 /// </summary>
-Game::Game() : deck(), state(GameState::Waiting)
+/// <param name="rules">The table rules, including the number of decks in the shoe.</param>
+/// <param name="penetration">The fraction of the shoe dealt before it is shuffled.</param>
+template <typename Rules, typename Random>
+BasicGame<Rules, Random>::BasicGame(const Rules& rules, float penetration)
+	: BasicGame(rules, penetration, (uint64_t)std::random_device()() << 32 | std::random_device()()) {}
+
+/// <summary>
+/// Constructor with an explicit seed, for reproducible games.
+/// </summary>
+/// <param name="rules">The table rules, including the number of decks in the shoe.</param>
+/// <param name="penetration">The fraction of the shoe dealt before it is shuffled.</param>
+/// <param name="seed">The seed.</param>
+template <typename Rules, typename Random>
+BasicGame<Rules, Random>::BasicGame(const Rules& rules, float penetration, uint64_t seed)
+	: BasicGame(1, rules, penetration, seed) {}
+
+/// <summary>
+/// Constructor for a table with several seats, with an explicit seed.
+/// </summary>
+/// <param name="seats">The number of seats, 1 to <see cref="BasicGame::MaxSeats"/>.</param>
+/// <param name="rules">The table rules, including the number of decks in the shoe.</param>
+/// <param name="penetration">The fraction of the shoe dealt before it is shuffled.</param>
+/// <param name="seed">The seed.</param>
+template <typename Rules, typename Random>
+BasicGame<Rules, Random>::BasicGame(int seats, const Rules& rules, float penetration, uint64_t seed)
+	: rules(rules), shoe(rules.decks, penetration), players(), seats(std::min(std::max(seats, 1), (int)MaxSeats)), seat(), results(), inPlay(),
+	state(GameState::Waiting), history()
 {
-	hand = new Hand();
-	player = new Player();
-	rng.seed(std::random_device()());
+	hand = pool.Acquire();
+	for (int i = 0; i < this->seats; i++)
+	{
+		players[i] = new Player(&pool);
+	}
+	player = players[0];
+	Seed(seed);
 }
 
 /// <summary>
-/// Pick a card from the deck.
-/// <para>If no cards are present, more cards are added to the deck.</para>
+/// Constructor continuing an existing random stream, for games split across streams.
 /// </summary>
-Card Game::PickCard()
+/// <param name="rules">The table rules, including the number of decks in the shoe.</param>
+/// <param name="penetration">The fraction of the shoe dealt before it is shuffled.</param>
+/// <param name="random">The random number generator's state.</param>
+template <typename Rules, typename Random>
+BasicGame<Rules, Random>::BasicGame(const Rules& rules, float penetration, const Random& random)
+	: rules(rules), shoe(rules.decks, penetration), players(), seats(1), seat(), results(), inPlay(),
+	state(GameState::Waiting), rng(random), history()
 {
-	// Check card count
-	if (deck.size() == 0)
+	hand = pool.Acquire();
+	players[0] = new Player(&pool);
+	player = players[0];
+	PopulateDeck();
+}
+
+/// <summary>
+/// Destructor.
+/// </summary>
+template <typename Rules, typename Random>
+BasicGame<Rules, Random>::~BasicGame()
+{
+	for (int i = 0; i < seats; i++)
 	{
-		// Populate deck with more cards.
-		PopulateDeck();
+		delete players[i];
 	}
-	// Pick a card
-	int index = rng() % deck.size();
-	Card card = deck.at(index);
-	// Remove card from deck at index
-	deck.erase(deck.begin() + index);
-	// Return card
-	return card;
+	pool.Release(hand);
 }
 
 /// <summary>
-/// Populate the deck with 52 cards.
+/// Reseeds the random number generator and shuffles the shoe.
 /// </summary>
-void Game::PopulateDeck()
+/// <param name="seed">The seed.</param>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::Seed(uint64_t seed)
 {
-	// Populate the deck with 13 cards of each suit.
-	// Up to 52 cards in total.
-	for (int i = 0; i < 13; i++)
+	rng.seed((typename Random::result_type)seed);
+	PopulateDeck();
+}
+
+/// <summary>
+/// Pick a card from the shoe.
+/// <para>If no cards are present, the cards dealt in earlier rounds are shuffled back in.</para>
+/// </summary>
+template <typename Rules, typename Random>
+Card BasicGame<Rules, Random>::PickCard()
+{
+	// Check card count
+	if (shoe.IsEmpty())
 	{
-		deck.push_back(Card((CardValue)i, CardSuit::CLUBS));
-		deck.push_back(Card((CardValue)i, CardSuit::DIAMONDS));
-		deck.push_back(Card((CardValue)i, CardSuit::HEARTS));
-		deck.push_back(Card((CardValue)i, CardSuit::SPADES));
+		// Only happens with deep penetration or a full table, the cards on the table stay out.
+		inPlay = shoe.Reshuffle(rng, inPlay);
 	}
-	// Shuffle the deck.
-	std::shuffle(deck.begin(), deck.end(), rng);
+	// Deal the next card
+	inPlay++;
+	return shoe.Draw();
+}
+
+/// <summary>
+/// Gather every card back into the shoe and shuffle it.
+/// </summary>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::PopulateDeck()
+{
+	shoe.Shuffle(rng);
+	inPlay = 0;
 }
 
 /// <summary>
 /// Deals a random card from the virtual deck.
 /// </summary>
-bool Game::Deal(bool checkBust)
+template <typename Rules, typename Random>
+bool BasicGame<Rules, Random>::Deal(bool checkBust)
 {
 	// Deal a card to the dealer.
 	hand->AddCard(PickCard());
@@ -89,224 +152,612 @@ bool Game::Deal(bool checkBust)
 	// Check if the dealer has busted.
 	if (hand->GetScore() > 21 && checkBust)
 	{
-		// The dealer has lost.
-		state = GameState::Win;
-		
-		// Payout bet to player.
-		player->SetBalance(player->GetBalance() + player->GetBet() * 1.5);
+		// Every hand still standing wins.
+		Settle();
 		
 		return true;
 	}
-	
-	// The player can now make a decision.
-	state = GameState::Active;
 
 	return false;
 }
 
 /// <summary>
-/// Get the hand.
+/// Deals a card to the player.
+/// <para>Once the player holds two cards, a natural blackjack settles the round, anything else starts the player's turn.</para>
 /// </summary>
-/// <returns>The hand.</returns>
-Hand* Game::GetHand()
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::DealPlayer()
 {
-	return hand;
+	Hand* current = player->GetHand();
+	if (state != GameState::Waiting || player->GetHandCount() != 1 || current->GetCount() >= 2)
+		return;
+
+	// Deal a card to the player.
+	current->AddCard(PickCard());
+	if (current->GetCount() < 2)
+		return;
+
+	// Does the player have a natural?
+	if (current->IsBlackjack())
+	{
+		results[0][0] = HandNatural;
+		Settle();
+		return;
+	}
+
+	// The player can now make a decision.
+	state = GameState::Active;
 }
 
 /// <summary>
-/// Get the player.
+/// Deals the opening cards in table order, one to each seat and then the dealer, twice.
+/// <para>Seats dealt a natural wait for settlement, the first seat left starts its turn.</para>
 /// </summary>
-/// <returns>The player.</returns>
-Player* Game::GetPlayer()
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::DealRound()
 {
-	return player;
+	if (state != GameState::Waiting || hand->GetCount() != 0)
+		return;
+
+	for (int round = 0; round < 2; round++)
+	{
+		for (int i = 0; i < seats; i++)
+		{
+			players[i]->GetHand(0)->AddCard(PickCard());
+		}
+		hand->AddCard(PickCard());
+	}
+
+	// Naturals are paid at settlement, everyone else plays in seat order.
+	for (int i = 0; i < seats; i++)
+	{
+		if (players[i]->GetHand(0)->IsBlackjack())
+		{
+			results[i][0] = HandNatural;
+		}
+	}
+	seat = -1;
+	if (!NextSeat())
+	{
+		Settle();
+	}
 }
 
 /// <summary>
-/// Get the state of the game.
+/// Checks the hand and the balance allow an action, whatever the state.
 /// </summary>
-/// <returns>The state of the game.</returns>
-GameState Game::GetState()
+/// <param name="action">The action.</param>
+/// <returns>True if the hand and balance allow it.</returns>
+template <typename Rules, typename Random>
+bool BasicGame<Rules, Random>::Allows(Action action)
 {
-	return state;
+	Hand* current = player->GetHand();
+	switch (action)
+	{
+	case DOUBLE:
+		// Two cards, after a split only if the rules allow it, and the balance must cover every bet.
+		return current->GetCount() == 2
+			&& (player->GetHandCount() == 1 || rules.doubleAfterSplit)
+			&& player->GetBalance() >= player->GetTotalBet() + player->GetHandBet(player->GetActive());
+	case SPLIT:
+		// Two cards of equal points, up to the hand limit and the hands left in the pool, and the balance must cover every bet.
+		return player->CanSplit()
+			&& current->GetCard(0).GetPoints() == current->GetCard(1).GetPoints()
+			&& player->GetHandCount() < std::min((int)rules.maxHands, (int)Player::MaxHands)
+			&& player->GetBalance() >= player->GetTotalBet() + player->GetHandBet(player->GetActive());
+	case SURRENDER:
+		// Late surrender, on the first two cards only.
+		return rules.lateSurrender && player->GetHandCount() == 1 && current->GetCount() == 2;
+	default:
+		return true;
+	}
 }
 
 /// <summary>
-/// Hit the hand.
+/// Gets the actions the player may take right now.
 /// </summary>
-void Game::Hit()
+/// <returns>The legal actions, empty unless it is the player's turn.</returns>
+template <typename Rules, typename Random>
+ActionSet BasicGame<Rules, Random>::GetLegalActions()
 {
-	// The player has chose to hit.
-	state = GameState::Waiting;
-	
-	// Deal a card to the player.
-	if (!player->AddCard(PickCard()))
-		return;
-	
-	// Did the player bust?
-	if (player->GetScore() > 21)
+	ActionSet legal = 0;
+	for (int i = 0; i < ActionCount; i++)
 	{
-		// The player has lost.
-		state = GameState::Lose;
-		
-		// Take bet from player, if they have enough.
-		if (player->GetBalance() >= player->GetBet())
+		if (transitions[state][i] != nullptr && Allows((Action)i))
 		{
-			player->SetBalance(player->GetBalance() - player->GetBet());
+			legal |= ActionBit((Action)i);
 		}
-		else
+	}
+	return legal;
+}
+
+/// <summary>
+/// Takes an action, if it is legal.
+/// </summary>
+/// <param name="action">The action.</param>
+/// <returns>False if the action is not legal, nothing changes.</returns>
+template <typename Rules, typename Random>
+bool BasicGame<Rules, Random>::Apply(Action action)
+{
+	if ((unsigned)action >= (unsigned)ActionCount)
+		return false;
+
+	Transition transition = transitions[state][action];
+	if (transition == nullptr || !Allows(action))
+		return false;
+
+	if (history != nullptr)
+	{
+		// The bet follows the hand until it is split or doubled, record any change made since the last action.
+		if (player->GetHandCount() == 1 && player->GetHandBet(0) != history->GetBet())
 		{
-			// The player has no money left.
-			state = GameState::GameOver;
+			history->ChangeBet(player->GetHandBet(0));
 		}
-		
-		return;
+		history->AddAction(action);
 	}
-	else if (player->GetScore() == 21)
-	{
-		// The player has won.
-		state = GameState::Win;
 
-		// Payout bet to player.
-		player->SetBalance(player->GetBalance() + player->GetBet() * 1.5);
+	(this->*transition)();
+	return true;
+}
 
-		return;
-	}
-	else if (player->GetScore() < 21)
+/// <summary>
+/// Checks if the dealer draws another card.
+/// </summary>
+template <typename Rules, typename Random>
+bool BasicGame<Rules, Random>::DealerHits()
+{
+	// Soft 17 only draws under H17.
+	int score = hand->GetScore();
+	return score < 17 || (rules.hitSoft17 && score == 17 && hand->IsSoft());
+}
+
+/// <summary>
+/// Deals the second card to a split hand that has become the hand being played.
+/// <para>Split aces stand on that card, so does 21.</para>
+/// </summary>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::PrepareHand()
+{
+	Hand* current = player->GetHand();
+	if (current->GetCount() == 1)
 	{
-		// Did the dealer bust outright?
-		if (hand->GetScore() > 21)
+		current->AddCard(PickCard());
+		if (current->GetCard(0).IsAce() || current->GetScore() == 21)
 		{
-			// The player has won.
-			state = GameState::Win;
+			results[seat][player->GetActive()] = HandStanding;
+			FinishHand();
+			return;
+		}
+	}
+	state = GameState::Active;
+}
 
-			// Payout bet to player.
-			player->SetBalance(player->GetBalance() + player->GetBet() * 1.5);
+/// <summary>
+/// Moves on to the next hand, then the next seat, or settles the round after the last one.
+/// </summary>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::FinishHand()
+{
+	if (player->NextHand())
+	{
+		PrepareHand();
+		return;
+	}
+	if (NextSeat())
+	{
+		return;
+	}
+	Settle();
+}
 
-			return;
+/// <summary>
+/// Moves on to the next seat with a decision to make.
+/// </summary>
+/// <returns>False if every seat has been played.</returns>
+template <typename Rules, typename Random>
+bool BasicGame<Rules, Random>::NextSeat()
+{
+	for (int i = seat + 1; i < seats; i++)
+	{
+		if (results[i][0] == HandPlaying)
+		{
+			seat = i;
+			player = players[i];
+			state = GameState::Active;
+			return true;
 		}
-		
-		// If the dealer's score is <= 16, deal
-		while (hand->GetScore() <= 16)
+	}
+	return false;
+}
+
+/// <summary>
+/// Plays out the dealer if any hand is still standing, then pays every hand of every seat in one pass.
+/// <para>The only place the round ends and money changes hands.</para>
+/// </summary>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::Settle()
+{
+	// Only play out the dealer against hands that are still standing.
+	bool standing = false;
+	for (int i = 0; i < seats; i++)
+	{
+		for (int j = 0; j < players[i]->GetHandCount(); j++)
 		{
-			if(Deal())
-				return;
+			standing = standing || results[i][j] == HandStanding;
 		}
+	}
+	while (standing && DealerHits())
+	{
+		Deal(false);
+	}
 
-		// Is the player's hand higher than the dealer's?
-		if (player->GetScore() > hand->GetScore())
+	// Lay every hand out in lanes, the payouts are worked out here so the pass below is only adds and compares.
+	const int lanes = seats * Player::MaxHands;
+	for (int i = 0; i < seats; i++)
+	{
+		for (int j = 0; j < Player::MaxHands; j++)
 		{
-			// The player has won.
-			state = GameState::Win;
+			int lane = i * Player::MaxHands + j;
+			bool playing = j < players[i]->GetHandCount();
+			Money bet = playing ? players[i]->GetHandBet(j) : Money();
+			laneBets[lane] = bet.cents;
+			laneNaturals[lane] = Payout{ rules.blackjackNumerator, rules.blackjackDenominator }.Apply(bet).cents;
+			laneSurrenders[lane] = Payout{ 1, 2 }.Forfeit(bet).cents;
+			laneScores[lane] = playing ? players[i]->GetHand(j)->GetScore() : 0;
+			laneStatus[lane] = playing ? results[i][j] : HandPlaying;
+		}
+	}
+
+	// Pay every hand. No branches, every lane computes every case and keeps the one that applies.
+	// A dealer blackjack beats any other 21, pushes a natural and takes the whole bet from a surrender.
+	const int64_t dealerScore = hand->GetScore();
+	const int64_t dealerBust = dealerScore > 21;
+	const int64_t dealerBlackjack = hand->IsBlackjack();
+	for (int lane = 0; lane < lanes; lane++)
+	{
+		int64_t bet = laneBets[lane];
+		int64_t score = laneScores[lane];
+		int64_t status = laneStatus[lane];
+		int64_t standing = status == HandStanding;
+		int64_t win = standing & (dealerBust | ((score > dealerScore) & (dealerBlackjack ^ 1)));
+		int64_t lose = (status == HandBusted) | (standing & (dealerBust ^ 1) & ((score < dealerScore) | dealerBlackjack));
+		int64_t natural = (status == HandNatural) & (dealerBlackjack ^ 1);
+		int64_t surrendered = status == HandSurrendered;
+		laneResults[lane] = (win - lose) * bet
+			+ natural * laneNaturals[lane]
+			- surrendered * (dealerBlackjack * bet + (dealerBlackjack ^ 1) * laneSurrenders[lane]);
+	}
 
-			// Payout bet to player.
-			player->SetBalance(player->GetBalance() + player->GetBet() * 1.5);
+	// The round is won or lost by its net result over every seat.
+	Money total = Money();
+	bool broke = false;
+	for (int i = 0; i < seats; i++)
+	{
+		Money net = Money();
+		for (int j = 0; j < Player::MaxHands; j++)
+		{
+			net.cents += laneResults[i * Player::MaxHands + j];
 		}
-		else if (player->GetScore() < hand->GetScore())
+		total += net;
+
+		// Take losses from the player, if they have enough.
+		if (players[i]->GetBalance() + net >= Money())
 		{
-			// The player has lost.
-			state = GameState::Lose;
-
-			// Take bet from player, if they have enough.
-			if (player->GetBalance() >= player->GetBet())
-			{
-				player->SetBalance(player->GetBalance() - player->GetBet());
-			}
-			else
-			{
-				// The player has no money left.
-				state = GameState::GameOver;
-			}
+			players[i]->Credit(net);
 		}
 		else
 		{
-			// The player has tied.
-			state = GameState::Push;
+			broke = true;
 		}
 	}
+	state = total > Money() ? GameState::Win : total < Money() ? GameState::Lose : GameState::Push;
+
+	if (broke)
+	{
+		// A player has no money left.
+		state = GameState::GameOver;
+	}
+
+	if (history != nullptr)
+	{
+		history->EndRound(hand, player, true, total);
+	}
 }
 
 /// <summary>
-/// Stand the hand.
+/// Get the hand.
 /// </summary>
-void Game::Stand()
+/// <returns>The hand.</returns>
+template <typename Rules, typename Random>
+Hand* BasicGame<Rules, Random>::GetHand()
 {
-	// The player has chose to stand.
-	state = GameState::Waiting;
+	return hand;
+}
 
-	// Did the dealer bust outright?
-	if (hand->GetScore() > 21)
-	{
-		// The player has won.
-		state = GameState::Win;
+/// <summary>
+/// Get the player.
+/// </summary>
+/// <returns>The player.</returns>
+template <typename Rules, typename Random>
+Player* BasicGame<Rules, Random>::GetPlayer()
+{
+	return player;
+}
 
-		// Payout bet to player.
-		player->SetBalance(player->GetBalance() + player->GetBet() * 1.5);
+/// <summary>
+/// Get the player in a seat.
+/// </summary>
+/// <param name="seat">The seat, 0 to <see cref="BasicGame::GetSeats"/> - 1.</param>
+/// <returns>The player.</returns>
+template <typename Rules, typename Random>
+Player* BasicGame<Rules, Random>::GetPlayer(int seat)
+{
+	return players[seat];
+}
 
-		return;
-	}
-	
-	// If the dealer's score is <= 16, deal
-	while (hand->GetScore() <= 16)
+/// <summary>
+/// Get the number of seats.
+/// </summary>
+/// <returns>The number of seats.</returns>
+template <typename Rules, typename Random>
+int BasicGame<Rules, Random>::GetSeats()
+{
+	return seats;
+}
+
+/// <summary>
+/// Get the shoe.
+/// </summary>
+/// <returns>The shoe.</returns>
+template <typename Rules, typename Random>
+Shoe* BasicGame<Rules, Random>::GetShoe()
+{
+	return &shoe;
+}
+
+/// <summary>
+/// Get the random number generator.
+/// <para>Use this to jump the generator to an independent stream, then call <see cref="BasicGame::PopulateDeck"/>.</para>
+/// </summary>
+/// <returns>The random number generator.</returns>
+template <typename Rules, typename Random>
+Random* BasicGame<Rules, Random>::GetRandom()
+{
+	return &rng;
+}
+
+/// <summary>
+/// Get the table rules.
+/// </summary>
+/// <returns>The table rules.</returns>
+template <typename Rules, typename Random>
+const Rules& BasicGame<Rules, Random>::GetRules()
+{
+	return rules;
+}
+
+/// <summary>
+/// Get the state of the game.
+/// </summary>
+/// <returns>The state of the game.</returns>
+template <typename Rules, typename Random>
+GameState BasicGame<Rules, Random>::GetState()
+{
+	return state;
+}
+
+/// <summary>
+/// Hit the hand being played.
+/// <para>The hand takes one card, and is finished once it busts or reaches 21.</para>
+/// </summary>
+/// <returns>False if hitting is not allowed.</returns>
+template <typename Rules, typename Random>
+bool BasicGame<Rules, Random>::Hit()
+{
+	return Apply(HIT);
+}
+
+/// <summary>
+/// Stand the hand being played.
+/// </summary>
+/// <returns>False if standing is not allowed.</returns>
+template <typename Rules, typename Random>
+bool BasicGame<Rules, Random>::Stand()
+{
+	return Apply(STAND);
+}
+
+/// <summary>
+/// Double the bet on the hand being played, take exactly one more card and stand.
+/// <para>Only allowed on two cards, after a split only if the rules allow it, and only if the balance covers every bet.</para>
+/// </summary>
+/// <returns>False if doubling is not allowed.</returns>
+template <typename Rules, typename Random>
+bool BasicGame<Rules, Random>::Double()
+{
+	return Apply(DOUBLE);
+}
+
+/// <summary>
+/// Split a pair into two hands, each carrying the original bet.
+/// <para>Only allowed on two cards of equal points, up to the rules' hand limit, and only if the balance covers every bet.
+/// Split aces take one card each and stand.</para>
+/// </summary>
+/// <returns>False if splitting is not allowed.</returns>
+template <typename Rules, typename Random>
+bool BasicGame<Rules, Random>::Split()
+{
+	return Apply(SPLIT);
+}
+
+/// <summary>
+/// Surrender the hand for half the bet.
+/// <para>Only allowed on the first two cards when the rules have late surrender.
+/// Surrendering into a dealer blackjack still loses the whole bet.</para>
+/// </summary>
+/// <returns>False if surrendering is not allowed.</returns>
+template <typename Rules, typename Random>
+bool BasicGame<Rules, Random>::Surrender()
+{
+	return Apply(SURRENDER);
+}
+
+/// <summary>
+/// The hand being played takes a card, and is finished once it busts or reaches 21.
+/// </summary>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::OnHit()
+{
+	Hand* current = player->GetHand();
+	current->AddCard(PickCard());
+	if (current->GetScore() > 21)
 	{
-		if(Deal())
-			return;
+		results[seat][player->GetActive()] = HandBusted;
+		FinishHand();
 	}
-	
-	// Is the player's hand higher than the dealer's?
-	if (player->GetScore() > hand->GetScore())
+	else if (current->GetScore() == 21)
 	{
-		// The player has won.
-		state = GameState::Win;
-
-		// Payout bet to player.
-		player->SetBalance(player->GetBalance() + player->GetBet() * 1.5);
+		results[seat][player->GetActive()] = HandStanding;
+		FinishHand();
 	}
-	else if (player->GetScore() < hand->GetScore())
-	{
-		// The player has lost.
-		state = GameState::Lose;
+}
 
-		// Take bet from player, if they have enough.
-		if (player->GetBalance() >= player->GetBet())
-		{
-			player->SetBalance(player->GetBalance() - player->GetBet());
-		}
-		else
-		{
-			// The player has no money left.
-			state = GameState::GameOver;
-		}
-	}
-	else
+/// <summary>
+/// The hand being played is finished.
+/// </summary>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::OnStand()
+{
+	results[seat][player->GetActive()] = HandStanding;
+	FinishHand();
+}
+
+/// <summary>
+/// The bet on the hand being played doubles, and the hand takes one card and is finished.
+/// </summary>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::OnDouble()
+{
+	Hand* current = player->GetHand();
+	player->Double();
+	current->AddCard(PickCard());
+	results[seat][player->GetActive()] = current->GetScore() > 21 ? HandBusted : HandStanding;
+	FinishHand();
+}
+
+/// <summary>
+/// The pair splits into two hands, the first is dealt its second card.
+/// </summary>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::OnSplit()
+{
+	// Allows has made sure there is room for the new hand.
+	player->Split();
+
+	// The new hand is still to be played.
+	for (int i = player->GetHandCount() - 1; i > player->GetActive() + 1; i--)
 	{
-		// The player has tied.
-		state = GameState::Push;
+		results[seat][i] = results[seat][i - 1];
 	}
+	results[seat][player->GetActive() + 1] = HandPlaying;
+
+	// Deal the second card to the hand being played.
+	PrepareHand();
+}
+
+/// <summary>
+/// The hand is given up and play moves on.
+/// </summary>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::OnSurrender()
+{
+	results[seat][0] = HandSurrendered;
+	FinishHand();
 }
 
 /// <summary>
 /// Resets the game.
+/// <para>The hands are cleared in place, starting a round does not allocate.</para>
 /// </summary>
-void Game::Start()
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::Start()
 {
-	// Reset deck.
-	deck.clear();
-	PopulateDeck();
+	// A round left unfinished is still recorded, its cards were dealt.
+	if (history != nullptr && history->IsRoundOpen())
+	{
+		history->EndRound(hand, player, false, Money());
+	}
+
+	// Shuffle once the cut card has been reached.
+	if (shoe.NeedsShuffle())
+	{
+		PopulateDeck();
+	}
+	inPlay = 0;
 
 	// Reset the hand.
-	hand = new Hand();
+	hand->Reset();
 
-	// Reset the player.
-	int balance = player->GetBalance();
-	int bet = player->GetBet();
-	if (player != nullptr)
+	// Reset the players, keeping their balance and bet.
+	for (int i = 0; i < seats; i++)
 	{
-		balance = player->GetBalance();
-		bet = player->GetBet();
+		players[i]->Reset();
+		for (int j = 0; j < Player::MaxHands; j++)
+		{
+			results[i][j] = HandPlaying;
+		}
 	}
-	player = new Player(balance, bet);
+	seat = 0;
+	player = players[0];
 
 	// Reset the state.
 	state = GameState::Waiting;
+
+	if (history != nullptr)
+	{
+		history->BeginRound(player->GetHandBet(0));
+	}
 }
+
+/// <summary>
+/// Records every round from the next <see cref="BasicGame::Start"/> on.
+/// <para>The log's header must describe this game's rules and seed, see <see cref="HistoryHeader::Describe"/>.</para>
+/// <para>A round still open in the previous log is recorded as unfinished.</para>
+/// </summary>
+/// <param name="history">The log, or nullptr to stop recording.</param>
+template <typename Rules, typename Random>
+void BasicGame<Rules, Random>::SetHistory(HistoryWriter* history)
+{
+	if (this->history != nullptr && this->history != history && this->history->IsRoundOpen())
+	{
+		this->history->EndRound(hand, player, false, Money());
+	}
+	this->history = history;
+}
+
+/// <summary>
+/// What each action does in each state, nullptr where the action is illegal.
+/// <para>Only <see cref="GameState::Active"/> accepts actions, the rest of the table keeps it that way.</para>
+/// </summary>
+template <typename Rules, typename Random>
+const typename BasicGame<Rules, Random>::Transition BasicGame<Rules, Random>::transitions[GameStateCount][ActionCount] =
+{
+	// Waiting
+	{ nullptr, nullptr, nullptr, nullptr, nullptr },
+	// Active: HIT, STAND, DOUBLE, SPLIT, SURRENDER
+	{ &BasicGame::OnHit, &BasicGame::OnStand, &BasicGame::OnDouble, &BasicGame::OnSplit, &BasicGame::OnSurrender },
+	// Win
+	{ nullptr, nullptr, nullptr, nullptr, nullptr },
+	// Lose
+	{ nullptr, nullptr, nullptr, nullptr, nullptr },
+	// Push
+	{ nullptr, nullptr, nullptr, nullptr, nullptr },
+	// GameOver
+	{ nullptr, nullptr, nullptr, nullptr, nullptr }
+};
+
+// Rules and generators the game is built with.
+template class KiwifruitDev::Blackjack::BasicGame<StandardRules, Xoshiro256>;
+template class KiwifruitDev::Blackjack::BasicGame<StandardRules, std::mt19937>;
+template class KiwifruitDev::Blackjack::BasicGame<SixFiveRules, Xoshiro256>;
+template class KiwifruitDev::Blackjack::BasicGame<RuntimeRules, Xoshiro256>;
@@ -29,12 +29,17 @@
 #include "player.hpp"
 #include "cards.hpp"
 #include "hand.hpp"
+#include "shoe.hpp"
+#include "rng.hpp"
+#include "rules.hpp"
 #include <random>
 
 namespace KiwifruitDev
 {
 	namespace Blackjack
 	{
+		class HistoryWriter;
+
 		enum GameState
 		{
 			/// <summary>
@@ -67,28 +72,142 @@ namespace KiwifruitDev
 			/// </summary>
 			GameOver
 		};
+
+		/// <summary>
+		/// The number of game states.
+		/// </summary>
+		const int GameStateCount = GameOver + 1;
+
+		/// <summary>
+		/// A decision the player can make on their turn.
+		/// </summary>
+		enum Action
+		{
+			HIT,
+			STAND,
+			DOUBLE,
+			SPLIT,
+			SURRENDER
+		};
+
+		/// <summary>
+		/// The number of actions.
+		/// </summary>
+		const int ActionCount = SURRENDER + 1;
+
+		/// <summary>
+		/// A set of actions, one bit per <see cref="Action"/>.
+		/// </summary>
+		typedef uint8_t ActionSet;
+
+		/// <summary>
+		/// Gets the bit for an action in an <see cref="ActionSet"/>.
+		/// </summary>
+		/// <param name="action">The action.</param>
+		/// <returns>The bit.</returns>
+		constexpr ActionSet ActionBit(Action action)
+		{
+			return (ActionSet)(1 << action);
+		}
+
+		/// <summary>
+		/// Where one of the player's hands stands in the round.
+		/// </summary>
+		enum HandStatus
+		{
+			/// <summary>
+			/// Still being played, or waiting for its turn.
+			/// </summary>
+			HandPlaying,
+
+			/// <summary>
+			/// Finished, compared with the dealer once every hand is finished.
+			/// </summary>
+			HandStanding,
+
+			/// <summary>
+			/// Went over 21.
+			/// </summary>
+			HandBusted,
+
+			/// <summary>
+			/// A natural blackjack on the first two cards.
+			/// </summary>
+			HandNatural,
+
+			/// <summary>
+			/// Given up for half the bet.
+			/// </summary>
+			HandSurrendered
+		};
 		
 		/// <summary>
-		/// Game logic.
+		/// Game logic, for one to <see cref="BasicGame::MaxSeats"/> seats sharing one shoe and one dealer hand.
+		/// <para>Seats play in order, each deciding through <see cref="BasicGame::Apply"/> while it is the seat being played.</para>
 		/// </summary>
-		class Game
+		/// <typeparam name="Rules">The table rules, see <see cref="FixedRules"/> and <see cref="RuntimeRules"/>.</typeparam>
+		/// <typeparam name="Random">The random number generator, see <see cref="Xoshiro256"/>.</typeparam>
+		template <typename Rules, typename Random>
+		class BasicGame
 		{
+		public:
+			/// <summary>
+			/// The most seats at a table.
+			/// </summary>
+			static const int MaxSeats = 7;
 		private:
 			/// <summary>
-			/// A virtual card deck.
-			/// <para>This is populated with 52 cards and then shuffled.</para>
+			/// The number of hands at a full table, one settlement lane each.
 			/// </summary>
-			std::vector<Card> deck;
+			static const int Lanes = MaxSeats * Player::MaxHands;
+
+			/// <summary>
+			/// The table rules.
+			/// </summary>
+			Rules rules;
+
+			/// <summary>
+			/// The shoe cards are dealt from.
+			/// </summary>
+			Shoe shoe;
+			
+			/// <summary>
+			/// Every hand at the table, the dealer's and the player's.
+			/// </summary>
+			HandPool pool;
 			
 			/// <summary>
 			/// The dealer's hand.
+			/// <para>Taken from the pool and reset in place every round.</para>
 			/// </summary>
 			Hand* hand;
 
 			/// <summary>
-			/// The player and their hand.
+			/// The player in each seat and their hands.
+			/// <para>Owned by the game and reset in place every round.</para>
+			/// </summary>
+			Player* players[MaxSeats];
+
+			/// <summary>
+			/// The number of seats.
+			/// </summary>
+			int seats;
+
+			/// <summary>
+			/// The seat being played, and its player.
 			/// </summary>
+			int seat;
 			Player* player;
+
+			/// <summary>
+			/// Where each seat's hands stand in the round.
+			/// </summary>
+			HandStatus results[MaxSeats][Player::MaxHands];
+
+			/// <summary>
+			/// The number of cards dealt this round, all still on the table.
+			/// </summary>
+			int inPlay;
 			
 			/// <summary>
 			/// The state of the game.
@@ -98,21 +217,135 @@ namespace KiwifruitDev
 			/// <summary>
 			/// Random number generator.
 			/// </summary>
-			std::mt19937 rng;
+			Random rng;
 
 			/// <summary>
-			/// Populate the deck with 52 cards.
+			/// Where rounds are recorded, if anywhere.
 			/// </summary>
-			void PopulateDeck();
+			HistoryWriter* history;
+
+			/// <summary>
+			/// Every hand at the table laid out one per lane, seat after seat, for settlement.
+			/// <para>Each field is its own array in cents, so paying every hand against the dealer is one pass the compiler can vectorize.
+			/// Hands a seat is not playing bet nothing and settle to nothing.</para>
+			/// </summary>
+			alignas(32) int64_t laneBets[Lanes];
+			alignas(32) int64_t laneNaturals[Lanes];
+			alignas(32) int64_t laneSurrenders[Lanes];
+			alignas(32) int64_t laneScores[Lanes];
+			alignas(32) int64_t laneStatus[Lanes];
+			alignas(32) int64_t laneResults[Lanes];
+
+			/// <summary>
+			/// Carries out an action that has already been checked.
+			/// </summary>
+			typedef void (BasicGame::*Transition)();
+
+			/// <summary>
+			/// What each action does in each state, nullptr where the action is illegal.
+			/// <para>Only <see cref="GameState::Active"/> accepts actions, the rest of the table keeps it that way.</para>
+			/// </summary>
+			static const Transition transitions[GameStateCount][ActionCount];
+
+			/// <summary>
+			/// Checks the hand and the balance allow an action, whatever the state.
+			/// </summary>
+			/// <param name="action">The action.</param>
+			/// <returns>True if the hand and balance allow it.</returns>
+			bool Allows(Action action);
+
+			/// <summary>
+			/// Transitions for each action.
+			/// </summary>
+			void OnHit();
+			void OnStand();
+			void OnDouble();
+			void OnSplit();
+			void OnSurrender();
+
+			/// <summary>
+			/// Checks if the dealer draws another card.
+			/// </summary>
+			bool DealerHits();
+
+			/// <summary>
+			/// Deals the second card to a split hand that has become the hand being played.
+			/// <para>Split aces stand on that card.</para>
+			/// </summary>
+			void PrepareHand();
+
+			/// <summary>
+			/// Moves on to the next hand, then the next seat, or settles the round after the last one.
+			/// </summary>
+			void FinishHand();
+
+			/// <summary>
+			/// Moves on to the next seat with a decision to make.
+			/// </summary>
+			/// <returns>False if every seat has been played.</returns>
+			bool NextSeat();
+
+			/// <summary>
+			/// Plays out the dealer if any hand is still standing, then pays every hand of every seat in one pass.
+			/// <para>The only place the round ends and money changes hands.</para>
+			/// </summary>
+			void Settle();
+
 		public:
 			/// <summary>
-			/// Constructor.
+			/// Gather every card back into the shoe and shuffle it.
+			/// </summary>
+			void PopulateDeck();
+
+			/// <summary>
+			/// Constructor, seeded from the system's random device.
+			/// </summary>
+			/// <param name="rules">The table rules, including the number of decks in the shoe.</param>
+			/// <param name="penetration">The fraction of the shoe dealt before it is shuffled.</param>
+			BasicGame(const Rules& rules = Rules(), float penetration = 0.75f);
+
+			/// <summary>
+			/// Constructor with an explicit seed, for reproducible games.
 			/// </summary>
-			Game();
+			/// <param name="rules">The table rules, including the number of decks in the shoe.</param>
+			/// <param name="penetration">The fraction of the shoe dealt before it is shuffled.</param>
+			/// <param name="seed">The seed.</param>
+			BasicGame(const Rules& rules, float penetration, uint64_t seed);
+
+			/// <summary>
+			/// Constructor for a table with several seats, with an explicit seed.
+			/// </summary>
+			/// <param name="seats">The number of seats, 1 to <see cref="BasicGame::MaxSeats"/>.</param>
+			/// <param name="rules">The table rules, including the number of decks in the shoe.</param>
+			/// <param name="penetration">The fraction of the shoe dealt before it is shuffled.</param>
+			/// <param name="seed">The seed.</param>
+			BasicGame(int seats, const Rules& rules, float penetration, uint64_t seed);
+
+			/// <summary>
+			/// Constructor continuing an existing random stream, for games split across streams.
+			/// </summary>
+			/// <param name="rules">The table rules, including the number of decks in the shoe.</param>
+			/// <param name="penetration">The fraction of the shoe dealt before it is shuffled.</param>
+			/// <param name="random">The random number generator's state.</param>
+			BasicGame(const Rules& rules, float penetration, const Random& random);
+
+			/// <summary>
+			/// Destructor.
+			/// </summary>
+			~BasicGame();
+
+			BasicGame(const BasicGame&) = delete;
+			BasicGame& operator=(const BasicGame&) = delete;
+
+			/// <summary>
+			/// Reseeds the random number generator and shuffles the shoe.
+			/// </summary>
+			/// <param name="seed">The seed.</param>
+			void Seed(uint64_t seed);
 			
 			/// <summary>
-			/// Pick a card from the deck.
-			/// <para>If no cards are present, more cards are added to the deck.</para>
+			/// Pick a card from the shoe.
+			/// <para>If no cards are present, the cards dealt in earlier rounds are shuffled back in.</para>
 			/// </summary>
 			Card PickCard();
 
@@ -123,6 +356,18 @@ namespace KiwifruitDev
 			/// </summary>
 			bool Deal(bool checkBust = true);
 
+			/// <summary>
+			/// Deals a card to the player, for a game with one seat.
+			/// <para>Once the player holds two cards, a natural blackjack settles the round, anything else starts the player's turn.</para>
+			/// </summary>
+			void DealPlayer();
+
+			/// <summary>
+			/// Deals the opening cards in table order, one to each seat and then the dealer, twice.
+			/// <para>Seats dealt a natural wait for settlement, the first seat left starts its turn.</para>
+			/// </summary>
+			void DealRound();
+
 			/// <summary>
 			/// Get the hand.
 			/// </summary>
@@ -130,11 +375,43 @@ namespace KiwifruitDev
 			Hand* GetHand();
 
 			/// <summary>
-			/// Get the player.
+			/// Get the player in the seat being played, or the last one once the round is over.
 			/// </summary>
 			/// <returns>The player.</returns>
 			Player* GetPlayer();
 
+			/// <summary>
+			/// Get the player in a seat.
+			/// </summary>
+			/// <param name="seat">The seat.</param>
+			/// <returns>The player.</returns>
+			Player* GetPlayer(int seat);
+
+			/// <summary>
+			/// Get the number of seats.
+			/// </summary>
+			/// <returns>The number of seats.</returns>
+			int GetSeats();
+
+			/// <summary>
+			/// Get the shoe.
+			/// </summary>
+			/// <returns>The shoe.</returns>
+			Shoe* GetShoe();
+
+			/// <summary>
+			/// Get the random number generator.
+			/// <para>Use this to jump the generator to an independent stream, then call <see cref="BasicGame::PopulateDeck"/>.</para>
+			/// </summary>
+			/// <returns>The random number generator.</returns>
+			Random* GetRandom();
+
+			/// <summary>
+			/// Get the table rules.
+			/// </summary>
+			/// <returns>The table rules.</returns>
+			const Rules& GetRules();
+
 			/// <summary>
 			/// Get the state of the game.
 			/// </summary>
@@ -142,24 +419,87 @@ namespace KiwifruitDev
 			GameState GetState();
 
 			/// <summary>
-			/// Hit the hand.
+			/// Gets the actions the player may take right now.
+			/// </summary>
+			/// <returns>The legal actions, empty unless it is the player's turn.</returns>
+			ActionSet GetLegalActions();
+
+			/// <summary>
+			/// Takes an action, if it is legal.
+			/// </summary>
+			/// <param name="action">The action.</param>
+			/// <returns>False if the action is not legal, nothing changes.</returns>
+			bool Apply(Action action);
+
+			/// <summary>
+			/// Hit the hand being played.
+			/// <para>The hand takes one card, and is finished once it busts or reaches 21.</para>
 			/// </summary>
-			void Hit();
+			/// <returns>False if hitting is not allowed.</returns>
+			bool Hit();
 			
 			/// <summary>
-			/// Stand the hand.
+			/// Stand the hand being played.
+			/// </summary>
+			/// <returns>False if standing is not allowed.</returns>
+			bool Stand();
+
+			/// <summary>
+			/// Double the bet on the hand being played, take exactly one more card and stand.
+			/// <para>Only allowed on two cards, after a split only if the rules allow it, and only if the balance covers every bet.</para>
+			/// </summary>
+			/// <returns>False if doubling is not allowed.</returns>
+			bool Double();
+
+			/// <summary>
+			/// Split a pair into two hands, each carrying the original bet.
+			/// <para>Only allowed on two cards of equal points, up to the rules' hand limit, and only if the balance covers every bet.
+			/// Split aces take one card each and stand.</para>
+			/// </summary>
+			/// <returns>False if splitting is not allowed.</returns>
+			bool Split();
+
+			/// <summary>
+			/// Surrender the hand for half the bet.
+			/// <para>Only allowed on the first two cards when the rules have late surrender.
+			/// Surrendering into a dealer blackjack still loses the whole bet.</para>
 			/// </summary>
-			void Stand();
+			/// <returns>False if surrendering is not allowed.</returns>
+			bool Surrender();
 			
 			/// <summary>
 			/// Resets the game.
+			/// <para>The hands are cleared in place, starting a round does not allocate.</para>
 			/// </summary>
 			void Start();
+
+			/// <summary>
+			/// Records every round from the next <see cref="BasicGame::Start"/> on, for a game with one seat.
+			/// <para>The log's header must describe this game's rules and seed, see <see cref="HistoryHeader::Describe"/>.</para>
+			/// <para>A round still open in the previous log is recorded as unfinished.</para>
+			/// </summary>
+			/// <param name="history">The log, or nullptr to stop recording.</param>
+			void SetHistory(HistoryWriter* history);
 		};
 
+		extern template class BasicGame<StandardRules, Xoshiro256>;
+		extern template class BasicGame<StandardRules, std::mt19937>;
+		extern template class BasicGame<SixFiveRules, Xoshiro256>;
+		extern template class BasicGame<RuntimeRules, Xoshiro256>;
+
+		/// <summary>
+		/// The game, with the standard rules and the default random number generator.
+		/// </summary>
+		typedef BasicGame<StandardRules, Xoshiro256> Game;
+
+		/// <summary>
+		/// The game, with rules chosen at runtime.
+		/// </summary>
+		typedef BasicGame<RuntimeRules, Xoshiro256> RuntimeGame;
+
 		/// <summary>
 		/// Static game instance.
 		/// </summary>
-		static Game* globalGame;
+		static RuntimeGame* globalGame;
 	}
 }
@@ -25,59 +25,55 @@
 */
 
 #include "hand.hpp"
-#include <iostream>
 
 using namespace KiwifruitDev::Blackjack;
 
 /// <summary>
 /// Default constructor.
 /// </summary>
-Hand::Hand() : score()
-{
-	cards = std::vector<Card>();
-}
+Hand::Hand() : cards(), count(), hardScore(), aces(), version() {}
 
 /// <summary>
-/// Add a card to the hand.
+/// Default constructor.
 /// </summary>
-/// <param name="card">The card to add.</param>
-/// <returns>True if the card was added, false if the hand is full.</returns>
-bool Hand::AddCard(Card card)
+HandPool::HandPool() : freeCount(Capacity)
 {
-	if (cards.size() < 11)
+	// Hand out the first hands first.
+	for (int i = 0; i < Capacity; i++)
 	{
-		cards.push_back(card);
-		// Update score.
-		score += card.GetValue(score);
-		return true;
+		free[i] = &hands[Capacity - 1 - i];
 	}
-	return false;
 }
 
 /// <summary>
-/// Gets the score of the hand.
+/// Takes an empty hand from the pool.
 /// </summary>
-/// <returns>The score of the hand.</returns>
-int Hand::GetScore()
+/// <returns>The hand, or nullptr if every hand is in use.</returns>
+Hand* HandPool::Acquire()
 {
-	return score;
+	if (freeCount == 0)
+	{
+		return nullptr;
+	}
+	Hand* hand = free[--freeCount];
+	hand->Reset();
+	return hand;
 }
 
 /// <summary>
-/// Gets the card at the specified index.
+/// Returns a hand to the pool.
 /// </summary>
-/// <param name="index">The index of the card.</param>
-/// <returns>The card at the specified index.</returns>
-Card Hand::GetCard(int index)
+/// <param name="hand">The hand, taken from this pool.</param>
+void HandPool::Release(Hand* hand)
 {
-	return cards[index];
+	free[freeCount++] = hand;
 }
 
 /// <summary>
-/// Gets the cards in the hand.
+/// Gets the number of hands not in use.
 /// </summary>
-/// <returns>The cards in the hand.</returns>
-std::vector<Card> Hand::GetCards()
+/// <returns>The number of hands not in use.</returns>
+int HandPool::GetFree()
 {
-	return cards;
+	return freeCount;
 }
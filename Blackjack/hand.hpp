@@ -27,58 +27,288 @@
 #pragma once
 
 #include "cards.hpp"
-#include <vector>
 
 namespace KiwifruitDev
 {
 	namespace Blackjack
 	{
+		/// <summary>
+		/// A read-only view of the cards in a hand.
+		/// <para>This does not own or copy the cards, it is only valid while the hand is alive.</para>
+		/// </summary>
+		struct CardView
+		{
+			/// <summary>
+			/// The first card.
+			/// </summary>
+			const Card* data;
+
+			/// <summary>
+			/// The number of cards.
+			/// </summary>
+			int count;
+
+			/// <summary>
+			/// Gets the number of cards.
+			/// </summary>
+			/// <returns>The number of cards.</returns>
+			int size() const
+			{
+				return count;
+			}
+
+			/// <summary>
+			/// Gets the first card, for range-based loops.
+			/// </summary>
+			const Card* begin() const
+			{
+				return data;
+			}
+
+			/// <summary>
+			/// Gets one past the last card, for range-based loops.
+			/// </summary>
+			const Card* end() const
+			{
+				return data + count;
+			}
+
+			/// <summary>
+			/// Gets the card at the specified index.
+			/// </summary>
+			/// <param name="index">The index of the card.</param>
+			/// <returns>The card at the specified index.</returns>
+			Card operator[](int index) const
+			{
+				return data[index];
+			}
+		};
+
 		/// <summary>
 		/// Hand class to hold cards.
+		/// <para>Cards are stored inline, so a hand never allocates.</para>
 		/// </summary>
 		class Hand
 		{
+		public:
+			/// <summary>
+			/// The most cards a hand can hold.
+			/// <para>21 aces reach a hard 21, so no hand ever needs more.</para>
+			/// </summary>
+			static const int MaxCards = 21;
 		protected:
 			/// <summary>
 			/// The cards in the hand.
 			/// </summary>
-			std::vector<Card> cards;
+			Card cards[MaxCards];
+
+			/// <summary>
+			/// The number of cards in the hand.
+			/// </summary>
+			int count;
+
+			/// <summary>
+			/// The score of the hand, counting every ace as 1.
+			/// </summary>
+			int hardScore;
 
 			/// <summary>
-			/// The score of the hand.
+			/// The number of aces in the hand.
+			/// <para>One of them counts as 11 when that does not bust the hand.</para>
 			/// </summary>
-			int score;
+			int aces;
+
+			/// <summary>
+			/// Incremented every time the hand changes.
+			/// </summary>
+			unsigned int version;
 		public:
 			/// <summary>
 			/// Default constructor.
 			/// </summary>
 			Hand();
 
+			/// <summary>
+			/// Removes every card from the hand.
+			/// </summary>
+			void Reset()
+			{
+				count = 0;
+				hardScore = 0;
+				aces = 0;
+				version++;
+			}
+
 			/// <summary>
 			/// Add a card to the hand.
 			/// </summary>
 			/// <param name="card">The card to add.</param>
 			/// <returns>True if the card was added, false if the hand is full.</returns>
-			bool AddCard(Card card);
+			bool AddCard(Card card)
+			{
+				if (count >= MaxCards)
+				{
+					return false;
+				}
+				cards[count++] = card;
+				// Update score.
+				hardScore += card.GetPoints();
+				aces += card.IsAce();
+				version++;
+				return true;
+			}
+
+			/// <summary>
+			/// Removes the last card from the hand, used to split a pair.
+			/// </summary>
+			/// <returns>The removed card.</returns>
+			Card PopCard()
+			{
+				Card card = cards[--count];
+				hardScore -= card.GetPoints();
+				aces -= card.IsAce();
+				version++;
+				return card;
+			}
 
 			/// <summary>
 			/// Gets the score of the hand.
+			/// <para>An ace counts as 11 if that does not bust the hand.</para>
 			/// </summary>
 			/// <returns>The score of the hand.</returns>
-			int GetScore();
+			int GetScore() const
+			{
+				return hardScore + 10 * IsSoft();
+			}
+
+			/// <summary>
+			/// Gets the score of the hand, counting every ace as 1.
+			/// </summary>
+			/// <returns>The hard score of the hand.</returns>
+			int GetHardScore() const
+			{
+				return hardScore;
+			}
+
+			/// <summary>
+			/// Checks if an ace in the hand is counted as 11.
+			/// </summary>
+			/// <returns>True if the hand is soft.</returns>
+			bool IsSoft() const
+			{
+				return (aces > 0) & (hardScore <= 11);
+			}
+
+			/// <summary>
+			/// Checks if the hand is a natural 21 made of two cards.
+			/// </summary>
+			/// <returns>True if the hand is a blackjack.</returns>
+			bool IsBlackjack() const
+			{
+				return (count == 2) & (GetScore() == 21);
+			}
+
+			/// <summary>
+			/// Checks if the hand is over 21.
+			/// </summary>
+			/// <returns>True if the hand is bust.</returns>
+			bool IsBust() const
+			{
+				return hardScore > 21;
+			}
+
+			/// <summary>
+			/// Gets the number of cards in the hand.
+			/// </summary>
+			/// <returns>The number of cards.</returns>
+			int GetCount() const
+			{
+				return count;
+			}
 
 			/// <summary>
 			/// Gets the card at the specified index.
 			/// </summary>
 			/// <param name="index">The index of the card.</param>
 			/// <returns>The card at the specified index.</returns>
-			Card GetCard(int index);
+			Card GetCard(int index) const
+			{
+				return cards[index];
+			}
 
 			/// <summary>
 			/// Gets the cards in the hand.
+			/// <para>The cards are not copied, see <see cref="CardView"/>.</para>
+			/// </summary>
+			/// <returns>A view of the cards in the hand.</returns>
+			CardView GetCards() const
+			{
+				return CardView{ cards, count };
+			}
+
+			/// <summary>
+			/// Gets the version of the hand.
+			/// <para>This changes whenever the hand changes, compare it to skip work on unchanged hands.</para>
+			/// </summary>
+			/// <returns>The version of the hand.</returns>
+			unsigned int GetVersion() const
+			{
+				return version;
+			}
+		};
+
+		/// <summary>
+		/// A fixed set of hands handed out to players and the dealer.
+		/// <para>Splitting takes a hand from the pool instead of allocating one.</para>
+		/// </summary>
+		class HandPool
+		{
+		public:
+			/// <summary>
+			/// The number of hands in the pool.
+			/// </summary>
+			static const int Capacity = 32;
+		private:
+			/// <summary>
+			/// The hands.
+			/// </summary>
+			Hand hands[Capacity];
+
+			/// <summary>
+			/// Hands not in use.
+			/// </summary>
+			Hand* free[Capacity];
+
+			/// <summary>
+			/// The number of hands not in use.
+			/// </summary>
+			int freeCount;
+		public:
+			/// <summary>
+			/// Default constructor.
+			/// </summary>
+			HandPool();
+
+			HandPool(const HandPool&) = delete;
+			HandPool& operator=(const HandPool&) = delete;
+
+			/// <summary>
+			/// Takes an empty hand from the pool.
+			/// </summary>
+			/// <returns>The hand, or nullptr if every hand is in use.</returns>
+			Hand* Acquire();
+
+			/// <summary>
+			/// Returns a hand to the pool.
+			/// </summary>
+			/// <param name="hand">The hand, taken from this pool.</param>
+			void Release(Hand* hand);
+
+			/// <summary>
+			/// Gets the number of hands not in use.
 			/// </summary>
-			/// <returns>The cards in the hand.</returns>
-			std::vector<Card> GetCards();
+			/// <returns>The number of hands not in use.</returns>
+			int GetFree();
 		};
 	}
 }
@@ -0,0 +1,653 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "history.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace KiwifruitDev::Blackjack;
+
+namespace
+{
+	const uint8_t Magic[4] = { 'B', 'J', 'H', 'L' };
+	const uint16_t Version = 1;
+	const int HeaderSize = 36;
+
+	// Little endian fields, written and read a byte at a time so the format does not depend on the host.
+	inline uint8_t* PutFixed(uint8_t* out, uint64_t value, int bytes)
+	{
+		for (int i = 0; i < bytes; i++)
+		{
+			*out++ = (uint8_t)(value >> (i * 8));
+		}
+		return out;
+	}
+
+	inline uint64_t GetFixed(const uint8_t* in, int bytes)
+	{
+		uint64_t value = 0;
+		for (int i = 0; i < bytes; i++)
+		{
+			value |= (uint64_t)in[i] << (i * 8);
+		}
+		return value;
+	}
+
+	// Seven bits per byte, the top bit set on every byte but the last.
+	inline uint8_t* PutVarint(uint8_t* out, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			*out++ = (uint8_t)(value | 0x80);
+			value >>= 7;
+		}
+		*out++ = (uint8_t)value;
+		return out;
+	}
+
+	// Small amounts of either sign stay small.
+	inline uint64_t ZigZag(int64_t value)
+	{
+		return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+	}
+
+	inline int64_t UnZigZag(uint64_t value)
+	{
+		return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	}
+
+	// Reads checked against the end of the log, any overrun marks the record as bad.
+	struct Cursor
+	{
+		const uint8_t* at;
+		const uint8_t* end;
+		bool bad;
+
+		uint8_t Byte()
+		{
+			if (at >= end)
+			{
+				bad = true;
+				return 0;
+			}
+			return *at++;
+		}
+
+		uint64_t Varint()
+		{
+			uint64_t value = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				uint8_t byte = Byte();
+				value |= (uint64_t)(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					return value;
+				}
+			}
+			bad = true;
+			return 0;
+		}
+
+		int Cards(Card* cards, int max)
+		{
+			int count = Byte();
+			if (count > max || end - at < count)
+			{
+				bad = true;
+				return 0;
+			}
+			for (int i = 0; i < count; i++)
+			{
+				cards[i].code = at[i];
+			}
+			at += count;
+			return count;
+		}
+	};
+}
+
+/// <summary>
+/// Gets the table rules.
+/// </summary>
+/// <returns>The rules.</returns>
+RuntimeRules HistoryHeader::GetRules() const
+{
+	RuntimeRules rules;
+	rules.decks = decks;
+	rules.hitSoft17 = hitSoft17 != 0;
+	rules.blackjackNumerator = blackjackNumerator;
+	rules.blackjackDenominator = blackjackDenominator;
+	rules.doubleAfterSplit = doubleAfterSplit != 0;
+	rules.maxHands = maxHands;
+	rules.lateSurrender = lateSurrender != 0;
+	return rules;
+}
+
+/// <summary>
+/// Constructor, creates the log and writes its header.
+/// </summary>
+/// <param name="path">The path of the log.</param>
+/// <param name="header">The seed and rules of the game being recorded.</param>
+HistoryWriter::HistoryWriter(const char* path, const HistoryHeader& header)
+	: size(), open(), startBet(), bet(), eventBytes(), eventCount(), rounds()
+{
+	file = fopen(path, "wb");
+	if (file == nullptr)
+	{
+		return;
+	}
+
+	// The buffer here already batches every write.
+	setvbuf(file, nullptr, _IONBF, 0);
+
+	uint32_t penetration;
+	memcpy(&penetration, &header.penetration, sizeof(penetration));
+	uint8_t* out = buffer;
+	memcpy(out, Magic, sizeof(Magic));
+	out += sizeof(Magic);
+	out = PutFixed(out, Version, 2);
+	out = PutFixed(out, 0, 2);
+	out = PutFixed(out, header.seed, 8);
+	out = PutFixed(out, header.stream, 8);
+	out = PutFixed(out, penetration, 4);
+	*out++ = header.decks;
+	*out++ = header.hitSoft17;
+	*out++ = header.blackjackNumerator;
+	*out++ = header.blackjackDenominator;
+	*out++ = header.doubleAfterSplit;
+	*out++ = header.maxHands;
+	*out++ = header.lateSurrender;
+	*out++ = 0;
+	size = (int)(out - buffer);
+}
+
+/// <summary>
+/// Destructor, writes every buffered record and closes the log.
+/// <para>A round still being played is not recorded.</para>
+/// </summary>
+HistoryWriter::~HistoryWriter()
+{
+	if (file == nullptr)
+	{
+		return;
+	}
+	Flush();
+	fclose(file);
+}
+
+/// <summary>
+/// Checks the log could be created.
+/// </summary>
+/// <returns>True if the log is open.</returns>
+bool HistoryWriter::IsOpen()
+{
+	return file != nullptr;
+}
+
+/// <summary>
+/// Checks if a round is being played.
+/// </summary>
+/// <returns>True if a round has begun and not ended.</returns>
+bool HistoryWriter::IsRoundOpen()
+{
+	return open;
+}
+
+/// <summary>
+/// Begins a round.
+/// </summary>
+/// <param name="bet">The bet.</param>
+void HistoryWriter::BeginRound(Money bet)
+{
+	open = true;
+	startBet = bet;
+	this->bet = bet;
+	eventBytes = 0;
+	eventCount = 0;
+}
+
+/// <summary>
+/// Adds an event to the round being played.
+/// </summary>
+/// <param name="event">The event.</param>
+/// <param name="bet">The bet, for <see cref="HistoryBetChange"/> only.</param>
+void HistoryWriter::AddEvent(uint8_t event, Money bet)
+{
+	// A round long enough to fill this is not one a strategy or a person plays.
+	if (!open || eventCount >= HistoryRound::MaxEvents)
+	{
+		return;
+	}
+	uint8_t* out = events + eventBytes;
+	*out++ = event;
+	if (event == HistoryBetChange)
+	{
+		out = PutVarint(out, (uint64_t)bet.cents);
+	}
+	eventBytes = (int)(out - events);
+	eventCount++;
+}
+
+/// <summary>
+/// Records an action taken in the round being played.
+/// </summary>
+/// <param name="action">The action.</param>
+void HistoryWriter::AddAction(Action action)
+{
+	AddEvent((uint8_t)action, Money());
+}
+
+/// <summary>
+/// Records a change to the bet in the round being played.
+/// </summary>
+/// <param name="bet">The new bet.</param>
+void HistoryWriter::ChangeBet(Money bet)
+{
+	AddEvent(HistoryBetChange, bet);
+	this->bet = bet;
+}
+
+/// <summary>
+/// Gets the bet of the round being played, as of the last event.
+/// </summary>
+/// <returns>The bet.</returns>
+Money HistoryWriter::GetBet()
+{
+	return bet;
+}
+
+/// <summary>
+/// Ends the round being played and adds its record to the log.
+/// </summary>
+/// <param name="dealer">The dealer's hand.</param>
+/// <param name="player">The player, with every hand they played.</param>
+/// <param name="settled">False if the round was abandoned.</param>
+/// <param name="net">The amount won (negative if lost) by the player, if settled.</param>
+void HistoryWriter::EndRound(const Hand* dealer, Player* player, bool settled, Money net)
+{
+	if (!open || file == nullptr)
+	{
+		return;
+	}
+	open = false;
+
+	if (BufferSize - size < MaxRecordSize)
+	{
+		Flush();
+	}
+
+	uint8_t* out = buffer + size;
+	*out++ = settled ? 1 : 0;
+	out = PutVarint(out, (uint64_t)startBet.cents);
+	*out++ = (uint8_t)dealer->GetCount();
+	for (int i = 0; i < dealer->GetCount(); i++)
+	{
+		*out++ = dealer->GetCard(i).code;
+	}
+	*out++ = (uint8_t)player->GetHandCount();
+	for (int h = 0; h < player->GetHandCount(); h++)
+	{
+		const Hand* hand = player->GetHand(h);
+		*out++ = (uint8_t)hand->GetCount();
+		for (int i = 0; i < hand->GetCount(); i++)
+		{
+			*out++ = hand->GetCard(i).code;
+		}
+	}
+	*out++ = (uint8_t)eventCount;
+	memcpy(out, events, eventBytes);
+	out += eventBytes;
+	if (settled)
+	{
+		out = PutVarint(out, ZigZag(net.cents));
+	}
+	size = (int)(out - buffer);
+	rounds++;
+}
+
+/// <summary>
+/// Writes every buffered record to the file.
+/// </summary>
+void HistoryWriter::Flush()
+{
+	if (file != nullptr && size > 0)
+	{
+		fwrite(buffer, 1, size, file);
+		fflush(file);
+	}
+	size = 0;
+}
+
+/// <summary>
+/// Gets the number of rounds recorded.
+/// </summary>
+/// <returns>The number of rounds.</returns>
+long long HistoryWriter::GetRounds()
+{
+	return rounds;
+}
+
+/// <summary>
+/// Constructor, maps a log and reads its header.
+/// </summary>
+/// <param name="path">The path of the log.</param>
+HistoryReader::HistoryReader(const char* path)
+	: data(), size(), position(), file(), mapping(), header(), corrupt(), start()
+{
+#ifdef _WIN32
+	HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+	file = handle;
+	LARGE_INTEGER length;
+	if (!GetFileSizeEx(handle, &length) || length.QuadPart < HeaderSize)
+	{
+		return;
+	}
+	mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		return;
+	}
+	data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr)
+	{
+		return;
+	}
+	size = (size_t)length.QuadPart;
+#else
+	int descriptor = open(path, O_RDONLY);
+	if (descriptor < 0)
+	{
+		return;
+	}
+	struct stat status;
+	if (fstat(descriptor, &status) != 0 || status.st_size < HeaderSize)
+	{
+		close(descriptor);
+		return;
+	}
+	void* view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor);
+	if (view == MAP_FAILED)
+	{
+		return;
+	}
+	// Records are read front to back exactly once.
+	madvise(view, (size_t)status.st_size, MADV_SEQUENTIAL);
+	mapping = view;
+	data = (const uint8_t*)view;
+	size = (size_t)status.st_size;
+#endif
+
+	if (memcmp(data, Magic, sizeof(Magic)) != 0 || GetFixed(data + 4, 2) != Version)
+	{
+		corrupt = true;
+		return;
+	}
+	uint32_t penetration = (uint32_t)GetFixed(data + 24, 4);
+	header.seed = GetFixed(data + 8, 8);
+	header.stream = GetFixed(data + 16, 8);
+	memcpy(&header.penetration, &penetration, sizeof(penetration));
+	header.decks = data[28];
+	header.hitSoft17 = data[29];
+	header.blackjackNumerator = data[30];
+	header.blackjackDenominator = data[31];
+	header.doubleAfterSplit = data[32];
+	header.maxHands = data[33];
+	header.lateSurrender = data[34];
+	start = position = HeaderSize;
+}
+
+/// <summary>
+/// Destructor, unmaps the log.
+/// </summary>
+HistoryReader::~HistoryReader()
+{
+#ifdef _WIN32
+	if (data != nullptr)
+	{
+		UnmapViewOfFile(data);
+	}
+	if (mapping != nullptr)
+	{
+		CloseHandle(mapping);
+	}
+	if (file != nullptr)
+	{
+		CloseHandle(file);
+	}
+#else
+	if (mapping != nullptr)
+	{
+		munmap(mapping, size);
+	}
+#endif
+}
+
+/// <summary>
+/// Checks the log was mapped and has a valid header.
+/// </summary>
+/// <returns>True if the log can be read.</returns>
+bool HistoryReader::IsOpen()
+{
+	return data != nullptr && start != 0;
+}
+
+/// <summary>
+/// Checks if a record was cut short or malformed.
+/// </summary>
+/// <returns>True if reading stopped early.</returns>
+bool HistoryReader::IsCorrupt()
+{
+	return corrupt;
+}
+
+/// <summary>
+/// Gets the header.
+/// </summary>
+/// <returns>The header.</returns>
+const HistoryHeader& HistoryReader::GetHeader()
+{
+	return header;
+}
+
+/// <summary>
+/// Reads the next round.
+/// </summary>
+/// <param name="round">Receives the round.</param>
+/// <returns>False at the end of the log, or if the record is corrupt.</returns>
+bool HistoryReader::Next(HistoryRound& round)
+{
+	if (!IsOpen() || corrupt || position >= size)
+	{
+		return false;
+	}
+
+	Cursor cursor = { data + position, data + size, false };
+	round.settled = (cursor.Byte() & 1) != 0;
+	round.bet = Money{ (int64_t)cursor.Varint() };
+	round.dealerCount = cursor.Cards(round.dealer, Hand::MaxCards);
+	round.handCount = cursor.Byte();
+	if (round.handCount > Player::MaxHands)
+	{
+		cursor.bad = true;
+	}
+	for (int h = 0; h < round.handCount && !cursor.bad; h++)
+	{
+		round.cardCounts[h] = cursor.Cards(round.hands[h], Hand::MaxCards);
+	}
+	round.eventCount = cursor.Byte();
+	for (int i = 0; i < round.eventCount && !cursor.bad; i++)
+	{
+		round.events[i] = cursor.Byte();
+		round.bets[i] = round.events[i] == HistoryBetChange ? Money{ (int64_t)cursor.Varint() } : Money();
+	}
+	round.net = round.settled ? Money{ UnZigZag(cursor.Varint()) } : Money();
+
+	if (cursor.bad)
+	{
+		corrupt = true;
+		return false;
+	}
+	position = cursor.at - data;
+	return true;
+}
+
+/// <summary>
+/// Goes back to the first round.
+/// </summary>
+void HistoryReader::Rewind()
+{
+	position = start;
+	corrupt = false;
+}
+
+/// <summary>
+/// Gets the number of rounds replayed per second.
+/// </summary>
+double ReplayResult::GetRoundsPerSecond() const
+{
+	return seconds > 0.0 ? rounds / seconds : 0.0;
+}
+
+namespace
+{
+	// Checks a hand holds exactly the recorded cards.
+	bool SameCards(const Hand* hand, const Card* cards, int count)
+	{
+		if (hand->GetCount() != count)
+		{
+			return false;
+		}
+		for (int i = 0; i < count; i++)
+		{
+			if (hand->GetCard(i).code != cards[i].code)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+/// <summary>
+/// Plays every round of a log again from its seed and actions, checking the cards and net match.
+/// </summary>
+/// <param name="reader">The log, read from its first round.</param>
+/// <returns>The result.</returns>
+ReplayResult KiwifruitDev::Blackjack::ReplayHistory(HistoryReader& reader)
+{
+	ReplayResult result;
+	const HistoryHeader& header = reader.GetHeader();
+	RuntimeGame game(header.GetRules(), header.penetration, header.seed);
+	if (header.stream != 0)
+	{
+		*game.GetRandom() = Xoshiro256::Stream(header.seed, header.stream);
+		game.PopulateDeck();
+	}
+
+	// Balances are not recorded, a bankroll this large allows every action the log took.
+	Player* player = game.GetPlayer();
+	const Money bankroll = Money::FromUnits(1000000000000LL);
+
+	HistoryRound round;
+	auto start = std::chrono::steady_clock::now();
+	while (reader.Next(round))
+	{
+		player->SetBalance(bankroll);
+		player->SetBet(round.bet);
+		game.Start();
+
+		// Deal the same way the round was dealt, as far as it got.
+		int dealerCards = round.settled ? 2 : std::min(round.dealerCount, 2);
+		int playerCards = round.settled ? 2 : round.handCount > 0 ? std::min(round.cardCounts[0], 2) : 0;
+		for (int i = 0; i < dealerCards; i++)
+		{
+			game.Deal(false);
+		}
+		for (int i = 0; i < playerCards; i++)
+		{
+			game.DealPlayer();
+		}
+
+		bool same = true;
+		for (int i = 0; i < round.eventCount; i++)
+		{
+			if (round.events[i] == HistoryBetChange)
+			{
+				player->SetBet(round.bets[i]);
+			}
+			else
+			{
+				same = same && game.Apply((Action)round.events[i]);
+			}
+		}
+
+		// The same cards must have been dealt to the same hands, for the same result.
+		GameState state = game.GetState();
+		bool settled = state != GameState::Waiting && state != GameState::Active;
+		Money net = player->GetBalance() - bankroll;
+		same = same && settled == round.settled && SameCards(game.GetHand(), round.dealer, round.dealerCount)
+			&& player->GetHandCount() == round.handCount && (!round.settled || net == round.net);
+		for (int h = 0; same && h < round.handCount; h++)
+		{
+			same = SameCards(player->GetHand(h), round.hands[h], round.cardCounts[h]);
+		}
+
+		if (!same)
+		{
+			if (result.firstMismatch < 0)
+			{
+				result.firstMismatch = result.rounds;
+			}
+			result.mismatches++;
+		}
+		if (round.settled)
+		{
+			result.settled++;
+			result.net += round.net;
+		}
+		result.rounds++;
+	}
+	auto end = std::chrono::steady_clock::now();
+	result.seconds = std::chrono::duration<double>(end - start).count();
+	return result;
+}
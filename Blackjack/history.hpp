@@ -0,0 +1,401 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "game.hpp"
+#include <cstdint>
+#include <cstdio>
+
+// Hand history, recorded as a compact binary log and replayed from a memory mapped file
+//
+// A log is a header followed by one record per round, every integer little endian:
+//   Header: "BJHL", u16 version, u16 reserved, u64 seed, u64 stream, f32 penetration,
+//           u8 decks, hit soft 17, blackjack numerator, blackjack denominator, double after split, max hands, late surrender, reserved
+//   Round:  u8 flags (1 = settled), varint bet in cents,
+//           u8 dealer card count and codes, u8 hand count then each hand's card count and codes,
+//           u8 event count and events (an Action, or 0xFF followed by a varint bet in cents),
+//           zigzag varint net in cents if settled.
+// Cards are one byte each, see Card::code. A typical round takes 12 to 16 bytes.
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// Everything needed to deal the same cards again: the seed, the generator stream and the rules.
+		/// </summary>
+		struct HistoryHeader
+		{
+			/// <summary>
+			/// The seed, and the <see cref="Xoshiro256::Stream"/> of it the game was dealt from.
+			/// <para>Stream 0 is the seed itself, as passed to <see cref="BasicGame::Seed"/>.</para>
+			/// </summary>
+			uint64_t seed;
+			uint64_t stream;
+
+			/// <summary>
+			/// The fraction of the shoe dealt before it is shuffled.
+			/// </summary>
+			float penetration;
+
+			/// <summary>
+			/// The table rules, see <see cref="RuntimeRules"/>.
+			/// </summary>
+			uint8_t decks;
+			uint8_t hitSoft17;
+			uint8_t blackjackNumerator;
+			uint8_t blackjackDenominator;
+			uint8_t doubleAfterSplit;
+			uint8_t maxHands;
+			uint8_t lateSurrender;
+
+			/// <summary>
+			/// Describes a game.
+			/// </summary>
+			/// <param name="rules">The table rules.</param>
+			/// <param name="penetration">The fraction of the shoe dealt before it is shuffled.</param>
+			/// <param name="seed">The seed.</param>
+			/// <param name="stream">The stream of the seed, 0 for the seed itself.</param>
+			/// <returns>The header.</returns>
+			template <typename Rules>
+			static HistoryHeader Describe(const Rules& rules, float penetration, uint64_t seed, uint64_t stream = 0)
+			{
+				HistoryHeader header;
+				header.seed = seed;
+				header.stream = stream;
+				header.penetration = penetration;
+				header.decks = (uint8_t)rules.decks;
+				header.hitSoft17 = rules.hitSoft17;
+				header.blackjackNumerator = (uint8_t)rules.blackjackNumerator;
+				header.blackjackDenominator = (uint8_t)rules.blackjackDenominator;
+				header.doubleAfterSplit = rules.doubleAfterSplit;
+				header.maxHands = (uint8_t)rules.maxHands;
+				header.lateSurrender = rules.lateSurrender;
+				return header;
+			}
+
+			/// <summary>
+			/// Gets the table rules.
+			/// </summary>
+			/// <returns>The rules.</returns>
+			RuntimeRules GetRules() const;
+		};
+
+		/// <summary>
+		/// An event that changes the bet instead of taking an action.
+		/// </summary>
+		const uint8_t HistoryBetChange = 0xFF;
+
+		/// <summary>
+		/// One round, as read back from a log.
+		/// </summary>
+		struct HistoryRound
+		{
+			/// <summary>
+			/// The most events a round records.
+			/// </summary>
+			static const int MaxEvents = 255;
+
+			/// <summary>
+			/// False if the round was abandoned before it was settled.
+			/// </summary>
+			bool settled;
+
+			/// <summary>
+			/// The bet the round started with.
+			/// </summary>
+			Money bet;
+
+			/// <summary>
+			/// The dealer's cards.
+			/// </summary>
+			Card dealer[Hand::MaxCards];
+			int dealerCount;
+
+			/// <summary>
+			/// The cards of each of the player's hands.
+			/// </summary>
+			Card hands[Player::MaxHands][Hand::MaxCards];
+			int cardCounts[Player::MaxHands];
+			int handCount;
+
+			/// <summary>
+			/// The actions taken in order, <see cref="HistoryBetChange"/> where the bet was changed to the matching bet.
+			/// </summary>
+			uint8_t events[MaxEvents];
+			Money bets[MaxEvents];
+			int eventCount;
+
+			/// <summary>
+			/// The amount won (negative if lost) by the player, if settled.
+			/// </summary>
+			Money net;
+		};
+
+		/// <summary>
+		/// Records rounds to a log as they are played.
+		/// <para>Records are built in memory and written in large blocks, nothing is written per card.</para>
+		/// </summary>
+		class HistoryWriter
+		{
+		public:
+			/// <summary>
+			/// The size of the write buffer.
+			/// </summary>
+			static const int BufferSize = 1 << 16;
+		private:
+			/// <summary>
+			/// The largest a round record can be.
+			/// </summary>
+			static const int MaxRecordSize = 1 + 10 + 1 + Hand::MaxCards + 1 + Player::MaxHands * (1 + Hand::MaxCards) + 1 + HistoryRound::MaxEvents * 11 + 10;
+
+			/// <summary>
+			/// The log file.
+			/// </summary>
+			FILE* file;
+
+			/// <summary>
+			/// Records waiting to be written.
+			/// </summary>
+			uint8_t buffer[BufferSize];
+			int size;
+
+			/// <summary>
+			/// The round being played: whether one is open, its bet as of the last event and its events.
+			/// </summary>
+			bool open;
+			Money startBet;
+			Money bet;
+			uint8_t events[HistoryRound::MaxEvents * 11];
+			int eventBytes;
+			int eventCount;
+
+			/// <summary>
+			/// The number of rounds recorded.
+			/// </summary>
+			long long rounds;
+
+			/// <summary>
+			/// Adds an event to the round being played.
+			/// </summary>
+			/// <param name="event">The event.</param>
+			/// <param name="bet">The bet, for <see cref="HistoryBetChange"/> only.</param>
+			void AddEvent(uint8_t event, Money bet);
+		public:
+			/// <summary>
+			/// Constructor, creates the log and writes its header.
+			/// </summary>
+			/// <param name="path">The path of the log.</param>
+			/// <param name="header">The seed and rules of the game being recorded.</param>
+			HistoryWriter(const char* path, const HistoryHeader& header);
+
+			/// <summary>
+			/// Destructor, writes every buffered record and closes the log.
+			/// <para>A round still being played is not recorded.</para>
+			/// </summary>
+			~HistoryWriter();
+
+			HistoryWriter(const HistoryWriter&) = delete;
+			HistoryWriter& operator=(const HistoryWriter&) = delete;
+
+			/// <summary>
+			/// Checks the log could be created.
+			/// </summary>
+			/// <returns>True if the log is open.</returns>
+			bool IsOpen();
+
+			/// <summary>
+			/// Checks if a round is being played.
+			/// </summary>
+			/// <returns>True if a round has begun and not ended.</returns>
+			bool IsRoundOpen();
+
+			/// <summary>
+			/// Begins a round.
+			/// </summary>
+			/// <param name="bet">The bet.</param>
+			void BeginRound(Money bet);
+
+			/// <summary>
+			/// Records an action taken in the round being played.
+			/// </summary>
+			/// <param name="action">The action.</param>
+			void AddAction(Action action);
+
+			/// <summary>
+			/// Records a change to the bet in the round being played.
+			/// </summary>
+			/// <param name="bet">The new bet.</param>
+			void ChangeBet(Money bet);
+
+			/// <summary>
+			/// Gets the bet of the round being played, as of the last event.
+			/// </summary>
+			/// <returns>The bet.</returns>
+			Money GetBet();
+
+			/// <summary>
+			/// Ends the round being played and adds its record to the log.
+			/// </summary>
+			/// <param name="dealer">The dealer's hand.</param>
+			/// <param name="player">The player, with every hand they played.</param>
+			/// <param name="settled">False if the round was abandoned.</param>
+			/// <param name="net">The amount won (negative if lost) by the player, if settled.</param>
+			void EndRound(const Hand* dealer, Player* player, bool settled, Money net);
+
+			/// <summary>
+			/// Writes every buffered record to the file.
+			/// </summary>
+			void Flush();
+
+			/// <summary>
+			/// Gets the number of rounds recorded.
+			/// </summary>
+			/// <returns>The number of rounds.</returns>
+			long long GetRounds();
+		};
+
+		/// <summary>
+		/// Reads a log back, mapped into memory so nothing is copied or read ahead by hand.
+		/// </summary>
+		class HistoryReader
+		{
+		private:
+			/// <summary>
+			/// The mapped log, and where the next record starts.
+			/// </summary>
+			const uint8_t* data;
+			size_t size;
+			size_t position;
+
+			/// <summary>
+			/// Operating system handles for the mapping.
+			/// </summary>
+			void* file;
+			void* mapping;
+
+			/// <summary>
+			/// The header.
+			/// </summary>
+			HistoryHeader header;
+
+			/// <summary>
+			/// Set once a record runs past the end of the log or does not make sense.
+			/// </summary>
+			bool corrupt;
+
+			/// <summary>
+			/// Where the first record starts.
+			/// </summary>
+			size_t start;
+		public:
+			/// <summary>
+			/// Constructor, maps a log and reads its header.
+			/// </summary>
+			/// <param name="path">The path of the log.</param>
+			HistoryReader(const char* path);
+
+			/// <summary>
+			/// Destructor, unmaps the log.
+			/// </summary>
+			~HistoryReader();
+
+			HistoryReader(const HistoryReader&) = delete;
+			HistoryReader& operator=(const HistoryReader&) = delete;
+
+			/// <summary>
+			/// Checks the log was mapped and has a valid header.
+			/// </summary>
+			/// <returns>True if the log can be read.</returns>
+			bool IsOpen();
+
+			/// <summary>
+			/// Checks if a record was cut short or malformed.
+			/// </summary>
+			/// <returns>True if reading stopped early.</returns>
+			bool IsCorrupt();
+
+			/// <summary>
+			/// Gets the header.
+			/// </summary>
+			/// <returns>The header.</returns>
+			const HistoryHeader& GetHeader();
+
+			/// <summary>
+			/// Reads the next round.
+			/// </summary>
+			/// <param name="round">Receives the round.</param>
+			/// <returns>False at the end of the log, or if the record is corrupt.</returns>
+			bool Next(HistoryRound& round);
+
+			/// <summary>
+			/// Goes back to the first round.
+			/// </summary>
+			void Rewind();
+		};
+
+		/// <summary>
+		/// The result of replaying a log.
+		/// </summary>
+		struct ReplayResult
+		{
+			/// <summary>
+			/// The number of rounds replayed, and how many of them were settled.
+			/// </summary>
+			long long rounds = 0;
+			long long settled = 0;
+
+			/// <summary>
+			/// The number of rounds that did not replay to the same cards and net, and the first of them.
+			/// </summary>
+			long long mismatches = 0;
+			long long firstMismatch = -1;
+
+			/// <summary>
+			/// Net amount won (negative if lost) over every settled round.
+			/// </summary>
+			Money net = Money();
+
+			/// <summary>
+			/// Wall clock time taken, in seconds.
+			/// </summary>
+			double seconds = 0.0;
+
+			/// <summary>
+			/// Gets the number of rounds replayed per second.
+			/// </summary>
+			double GetRoundsPerSecond() const;
+		};
+
+		/// <summary>
+		/// Plays every round of a log again from its seed and actions, checking the cards and net match.
+		/// </summary>
+		/// <param name="reader">The log, read from its first round.</param>
+		/// <returns>The result.</returns>
+		ReplayResult ReplayHistory(HistoryReader& reader);
+	}
+}
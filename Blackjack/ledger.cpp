@@ -0,0 +1,148 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "ledger.hpp"
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Default constructor.
+/// </summary>
+LedgerBatch::LedgerBatch() : count(), settled(), rebought() {}
+
+/// <summary>
+/// Constructor.
+/// </summary>
+/// <param name="shards">The number of shards, one per thread that commits.</param>
+/// <param name="keepLog">Keep every transaction, not only the totals.</param>
+Ledger::Ledger(int shards, bool keepLog) : shards(new Shard[shards < 1 ? 1 : shards]), shardCount(shards < 1 ? 1 : shards), keepLog(keepLog)
+{
+	for (int i = 0; i < shardCount; i++)
+	{
+		this->shards[i].settled = 0;
+		this->shards[i].rebought = 0;
+		this->shards[i].transactions = 0;
+	}
+}
+
+/// <summary>
+/// Commits a batch to a shard and empties it.
+/// <para>Each shard must only be committed to by one thread at a time.</para>
+/// </summary>
+/// <param name="shard">The shard.</param>
+/// <param name="batch">The batch.</param>
+void Ledger::Commit(int shard, LedgerBatch& batch)
+{
+	Shard& target = shards[shard % shardCount];
+	if (keepLog)
+	{
+		target.log.insert(target.log.end(), batch.entries, batch.entries + batch.count);
+	}
+	target.settled.fetch_add(batch.settled.cents, std::memory_order_relaxed);
+	target.rebought.fetch_add(batch.rebought.cents, std::memory_order_relaxed);
+	target.transactions.fetch_add(batch.count, std::memory_order_release);
+
+	batch.count = 0;
+	batch.settled = Money();
+	batch.rebought = Money();
+}
+
+/// <summary>
+/// Gets the net of every settlement committed.
+/// </summary>
+Money Ledger::GetSettled()
+{
+	Money total = Money();
+	for (int i = 0; i < shardCount; i++)
+	{
+		total.cents += shards[i].settled.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+/// <summary>
+/// Gets the total of every rebuy committed.
+/// </summary>
+Money Ledger::GetRebought()
+{
+	Money total = Money();
+	for (int i = 0; i < shardCount; i++)
+	{
+		total.cents += shards[i].rebought.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+/// <summary>
+/// Gets the number of transactions committed.
+/// </summary>
+uint64_t Ledger::GetTransactions()
+{
+	uint64_t total = 0;
+	for (int i = 0; i < shardCount; i++)
+	{
+		total += shards[i].transactions.load(std::memory_order_acquire);
+	}
+	return total;
+}
+
+/// <summary>
+/// Gets a shard's log.
+/// </summary>
+/// <param name="shard">The shard.</param>
+/// <returns>The log, empty unless the ledger keeps one.</returns>
+const std::vector<Transaction>& Ledger::GetLog(int shard)
+{
+	return shards[shard % shardCount].log;
+}
+
+/// <summary>
+/// Checks that the logs add up to the totals, to the cent.
+/// <para>Always true when no log is kept.</para>
+/// </summary>
+/// <returns>True if the ledger balances.</returns>
+bool Ledger::Audit()
+{
+	if (!keepLog)
+	{
+		return true;
+	}
+	for (int i = 0; i < shardCount; i++)
+	{
+		Money settled = Money();
+		Money rebought = Money();
+		for (const Transaction& transaction : shards[i].log)
+		{
+			(transaction.kind == TransactionSettle ? settled : rebought) += transaction.amount;
+		}
+		if (settled.cents != shards[i].settled || rebought.cents != shards[i].rebought
+			|| shards[i].log.size() != shards[i].transactions)
+		{
+			return false;
+		}
+	}
+	return true;
+}
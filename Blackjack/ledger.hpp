@@ -0,0 +1,323 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Money and the ledger
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// An amount of money in whole cents.
+		/// <para>Fixed point, so sums are exact no matter how many rounds are played.</para>
+		/// </summary>
+		struct Money
+		{
+			/// <summary>
+			/// The amount in cents.
+			/// </summary>
+			int64_t cents;
+
+			/// <summary>
+			/// Creates an amount from whole units.
+			/// </summary>
+			/// <param name="units">The amount in units.</param>
+			/// <returns>The amount.</returns>
+			static constexpr Money FromUnits(int64_t units)
+			{
+				return Money{ units * 100 };
+			}
+
+			/// <summary>
+			/// Gets the whole units, rounded toward zero.
+			/// </summary>
+			constexpr int64_t GetUnits() const
+			{
+				return cents / 100;
+			}
+
+			/// <summary>
+			/// Gets the cents left over after the whole units, negative for negative amounts.
+			/// </summary>
+			constexpr int64_t GetCents() const
+			{
+				return cents % 100;
+			}
+
+			constexpr Money operator+(Money other) const { return Money{ cents + other.cents }; }
+			constexpr Money operator-(Money other) const { return Money{ cents - other.cents }; }
+			constexpr Money operator-() const { return Money{ -cents }; }
+			constexpr Money operator*(int64_t factor) const { return Money{ cents * factor }; }
+			Money& operator+=(Money other) { cents += other.cents; return *this; }
+			Money& operator-=(Money other) { cents -= other.cents; return *this; }
+			constexpr bool operator==(Money other) const { return cents == other.cents; }
+			constexpr bool operator!=(Money other) const { return cents != other.cents; }
+			constexpr bool operator<(Money other) const { return cents < other.cents; }
+			constexpr bool operator<=(Money other) const { return cents <= other.cents; }
+			constexpr bool operator>(Money other) const { return cents > other.cents; }
+			constexpr bool operator>=(Money other) const { return cents >= other.cents; }
+		};
+
+		/// <summary>
+		/// A payout as an exact ratio, 3:2 pays 3 for every 2 bet.
+		/// </summary>
+		struct Payout
+		{
+			int64_t numerator;
+			int64_t denominator;
+
+			/// <summary>
+			/// Gets the winnings on a bet.
+			/// <para>Exact for any whole unit bet at 3:2 or 6:5, fractions of a cent are rounded down and go to the house.</para>
+			/// </summary>
+			/// <param name="bet">The bet.</param>
+			/// <returns>The winnings.</returns>
+			constexpr Money Apply(Money bet) const
+			{
+				return Money{ bet.cents * numerator / denominator };
+			}
+
+			/// <summary>
+			/// Gets the part of a bet the player gives up, such as half of it on a surrender.
+			/// <para>Fractions of a cent are rounded up, so they still go to the house.</para>
+			/// </summary>
+			/// <param name="bet">The bet.</param>
+			/// <returns>The amount lost.</returns>
+			constexpr Money Forfeit(Money bet) const
+			{
+				return Money{ (bet.cents * numerator + denominator - 1) / denominator };
+			}
+		};
+
+		/// <summary>
+		/// Why money moved.
+		/// </summary>
+		enum TransactionKind : uint8_t
+		{
+			/// <summary>
+			/// A round won, lost or pushed, the amount is the net for the round.
+			/// </summary>
+			TransactionSettle,
+
+			/// <summary>
+			/// Money added to a broke player's balance.
+			/// </summary>
+			TransactionRebuy
+		};
+
+		/// <summary>
+		/// One entry in the ledger, from the player's side.
+		/// </summary>
+		struct Transaction
+		{
+			/// <summary>
+			/// Which player or simulator the money belongs to.
+			/// </summary>
+			uint32_t account;
+
+			/// <summary>
+			/// Why the money moved.
+			/// </summary>
+			TransactionKind kind;
+
+			/// <summary>
+			/// The amount, positive when the player received money.
+			/// </summary>
+			Money amount;
+		};
+
+		/// <summary>
+		/// Transactions collected by one thread and committed to the ledger together.
+		/// <para>Adding to a batch touches no shared memory.</para>
+		/// </summary>
+		class LedgerBatch
+		{
+		public:
+			/// <summary>
+			/// The most transactions a batch holds before it must be committed.
+			/// </summary>
+			static const int Capacity = 256;
+		private:
+			/// <summary>
+			/// The transactions.
+			/// </summary>
+			Transaction entries[Capacity];
+
+			/// <summary>
+			/// The number of transactions.
+			/// </summary>
+			int count;
+
+			/// <summary>
+			/// Settlements and rebuys in the batch, summed as they are added.
+			/// </summary>
+			Money settled;
+			Money rebought;
+
+			friend class Ledger;
+		public:
+			/// <summary>
+			/// Default constructor.
+			/// </summary>
+			LedgerBatch();
+
+			/// <summary>
+			/// Adds a transaction.
+			/// </summary>
+			/// <param name="account">The account.</param>
+			/// <param name="kind">Why the money moved.</param>
+			/// <param name="amount">The amount, positive when the player received money.</param>
+			/// <returns>False if the batch is full and has to be committed first.</returns>
+			bool Add(uint32_t account, TransactionKind kind, Money amount)
+			{
+				if (count >= Capacity)
+				{
+					return false;
+				}
+				entries[count++] = Transaction{ account, kind, amount };
+				if (kind == TransactionSettle)
+				{
+					settled += amount;
+				}
+				else
+				{
+					rebought += amount;
+				}
+				return true;
+			}
+
+			/// <summary>
+			/// Checks if the batch has to be committed before the next transaction.
+			/// </summary>
+			bool IsFull() const
+			{
+				return count >= Capacity;
+			}
+
+			/// <summary>
+			/// Gets the number of transactions.
+			/// </summary>
+			int GetCount() const
+			{
+				return count;
+			}
+		};
+
+		/// <summary>
+		/// Totals and an optional append-only log of every transaction.
+		/// <para>The ledger is split into shards, one per writer. Committing a batch is a few atomic adds on the writer's own shard,
+		/// so threads never wait on each other and never share a cache line.</para>
+		/// </summary>
+		class Ledger
+		{
+		private:
+			/// <summary>
+			/// One writer's part of the ledger.
+			/// </summary>
+			struct alignas(64) Shard
+			{
+				std::atomic<int64_t> settled;
+				std::atomic<int64_t> rebought;
+				std::atomic<uint64_t> transactions;
+
+				/// <summary>
+				/// Every transaction committed to this shard, in order.
+				/// <para>Only the shard's writer appends to it.</para>
+				/// </summary>
+				std::vector<Transaction> log;
+			};
+
+			/// <summary>
+			/// The shards.
+			/// </summary>
+			std::unique_ptr<Shard[]> shards;
+
+			/// <summary>
+			/// The number of shards.
+			/// </summary>
+			int shardCount;
+
+			/// <summary>
+			/// Whether transactions are logged, or only counted.
+			/// </summary>
+			bool keepLog;
+		public:
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			/// <param name="shards">The number of shards, one per thread that commits.</param>
+			/// <param name="keepLog">Keep every transaction, not only the totals.</param>
+			Ledger(int shards, bool keepLog = false);
+
+			Ledger(const Ledger&) = delete;
+			Ledger& operator=(const Ledger&) = delete;
+
+			/// <summary>
+			/// Commits a batch to a shard and empties it.
+			/// <para>Each shard must only be committed to by one thread at a time.</para>
+			/// </summary>
+			/// <param name="shard">The shard.</param>
+			/// <param name="batch">The batch.</param>
+			void Commit(int shard, LedgerBatch& batch);
+
+			/// <summary>
+			/// Gets the net of every settlement committed.
+			/// </summary>
+			Money GetSettled();
+
+			/// <summary>
+			/// Gets the total of every rebuy committed.
+			/// </summary>
+			Money GetRebought();
+
+			/// <summary>
+			/// Gets the number of transactions committed.
+			/// </summary>
+			uint64_t GetTransactions();
+
+			/// <summary>
+			/// Gets a shard's log.
+			/// </summary>
+			/// <param name="shard">The shard.</param>
+			/// <returns>The log, empty unless the ledger keeps one.</returns>
+			const std::vector<Transaction>& GetLog(int shard);
+
+			/// <summary>
+			/// Checks that the logs add up to the totals, to the cent.
+			/// <para>Always true when no log is kept.</para>
+			/// </summary>
+			/// <returns>True if the ledger balances.</returns>
+			bool Audit();
+		};
+	}
+}
@@ -0,0 +1,369 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "logic.hpp"
+#include <algorithm>
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Constructor, every slot starts zeroed.
+/// </summary>
+SnapshotBuffer::SnapshotBuffer() : slots(), middle(1), back(0), front(2) {}
+
+/// <summary>
+/// Gets the slot to write the next snapshot into, writer only.
+/// </summary>
+/// <returns>The back slot, which holds an old snapshot.</returns>
+TableSnapshot& SnapshotBuffer::GetBack()
+{
+	return slots[back];
+}
+
+/// <summary>
+/// Hands the back slot to the reader, writer only.
+/// </summary>
+void SnapshotBuffer::Publish()
+{
+	// Release the writes to the slot, acquire whichever slot the reader last gave up.
+	back = middle.exchange(back | Fresh, std::memory_order_acq_rel) & 3;
+}
+
+/// <summary>
+/// Takes the newest published snapshot if there is one, reader only.
+/// </summary>
+/// <returns>True if the front slot changed.</returns>
+bool SnapshotBuffer::Update()
+{
+	if (!(middle.load(std::memory_order_relaxed) & Fresh))
+	{
+		return false;
+	}
+	front = middle.exchange(front, std::memory_order_acq_rel) & 3;
+	return true;
+}
+
+/// <summary>
+/// Gets the newest snapshot taken, reader only.
+/// </summary>
+/// <returns>The front slot.</returns>
+const TableSnapshot& SnapshotBuffer::GetFront()
+{
+	return slots[front];
+}
+
+/// <summary>
+/// Constructor.
+/// </summary>
+CommandQueue::CommandQueue() : commands(), tail(0), head(0) {}
+
+/// <summary>
+/// Adds a press, producer only.
+/// </summary>
+/// <param name="command">The press.</param>
+/// <returns>False if the queue is full and the press was dropped.</returns>
+bool CommandQueue::Push(FrameInput command)
+{
+	uint32_t position = tail.load(std::memory_order_relaxed);
+	if (position - head.load(std::memory_order_acquire) >= Capacity)
+	{
+		return false;
+	}
+	commands[position & (Capacity - 1)] = command;
+	tail.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+/// <summary>
+/// Takes the oldest press, consumer only.
+/// </summary>
+/// <param name="command">Receives the press.</param>
+/// <returns>False if the queue is empty.</returns>
+bool CommandQueue::Pop(FrameInput& command)
+{
+	uint32_t position = head.load(std::memory_order_relaxed);
+	if (position == tail.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	command = commands[position & (Capacity - 1)];
+	head.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+/// <summary>
+/// Constructor, takes the first snapshot and starts the thread.
+/// </summary>
+/// <param name="game">The game, already started, which the thread owns until it stops.</param>
+/// <param name="strategy">The strategy that plays in autoplay.</param>
+/// <param name="step">The time between updates, in seconds.</param>
+LogicThread::LogicThread(RuntimeGame* game, Strategy strategy, double step)
+	: game(game), frame(game), step(step), applied(0), clicks(0), strategy(strategy), stats(), running(true)
+{
+	stats.bankrollEvery = 1;
+	Capture(snapshots.GetBack());
+	snapshots.Publish();
+	thread = std::thread(&LogicThread::Run, this);
+}
+
+/// <summary>
+/// Destructor, stops the thread.
+/// </summary>
+LogicThread::~LogicThread()
+{
+	running.store(false, std::memory_order_release);
+	thread.join();
+}
+
+/// <summary>
+/// The thread's main loop.
+/// </summary>
+void LogicThread::Run()
+{
+	Clock::duration interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(step));
+	Clock::duration autoplayInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / AutoplayRate));
+	Clock::time_point next = Clock::now();
+	Clock::time_point rateStart = next;
+	long long rateRounds = 0;
+	uint32_t published = frame.GetVersion();
+	uint32_t publishedApplied = applied;
+	while (running.load(std::memory_order_acquire))
+	{
+		// Every waiting press gets an update of its own, so each sees the one before it
+		int sounds = FrameSilent;
+		FrameInput command;
+		bool pressed = false;
+		while (commands.Pop(command))
+		{
+			applied++;
+			pressed = true;
+			// The strategy takes over the table, or hands it back with a fresh round
+			if (command == InputAutoplay)
+			{
+				// Millions of rounds are not worth recording, and a log missing rounds can no longer be replayed past them
+				if (!stats.enabled)
+				{
+					game->SetHistory(nullptr);
+				}
+				stats.enabled = !stats.enabled;
+				rateStart = Clock::now();
+				rateRounds = stats.rounds;
+				if (!stats.enabled)
+				{
+					sounds |= frame.Update(InputReset);
+				}
+				continue;
+			}
+			// Buttons wait while the strategy plays
+			sounds |= frame.Update(stats.enabled ? InputNone : command);
+		}
+		if (!pressed)
+		{
+			sounds |= frame.Update(InputNone);
+		}
+		clicks += (sounds & FrameClick) != 0;
+
+		if (stats.enabled)
+		{
+			// Rounds until the next snapshot is due, then the rate over the last half second
+			next = Clock::now() + autoplayInterval;
+			Autoplay(next);
+			double elapsed = std::chrono::duration<double>(next - rateStart).count();
+			if (elapsed >= 0.5)
+			{
+				stats.handsPerSecond = (stats.rounds - rateRounds) / elapsed;
+				rateStart = next;
+				rateRounds = stats.rounds;
+			}
+			Capture(snapshots.GetBack());
+			snapshots.Publish();
+			published = frame.GetVersion();
+			publishedApplied = applied;
+			continue;
+		}
+
+		// Only changes are published, an idle table costs the window nothing
+		if (frame.GetVersion() != published || applied != publishedApplied)
+		{
+			Capture(snapshots.GetBack());
+			snapshots.Publish();
+			published = frame.GetVersion();
+			publishedApplied = applied;
+		}
+
+		// Fixed steps, late ones are caught up unless the thread fell far behind
+		next += interval;
+		Clock::time_point after = Clock::now();
+		if (next < after - interval * 4)
+		{
+			next = after;
+		}
+		std::this_thread::sleep_until(next);
+	}
+}
+
+/// <summary>
+/// Gets the button that takes an action.
+/// </summary>
+/// <param name="action">The action.</param>
+/// <returns>The button.</returns>
+static FrameInput ToInput(Action action)
+{
+	switch (action)
+	{
+	case HIT:
+		return InputHit;
+	case DOUBLE:
+		return InputDouble;
+	case SPLIT:
+		return InputSplit;
+	case SURRENDER:
+		return InputSurrender;
+	default:
+		return InputStand;
+	}
+}
+
+/// <summary>
+/// Plays whole rounds with the strategy until a time.
+/// </summary>
+/// <param name="until">When to stop, checked between rounds.</param>
+void LogicThread::Autoplay(Clock::time_point until)
+{
+	Player* player = game->GetPlayer();
+	do
+	{
+		// Top up before a round could lose more than is left, four doubled hands at most
+		if (player->GetBalance() < player->GetBet() * (Player::MaxHands * 2))
+		{
+			player->SetBalance(Money::FromUnits(1000));
+			stats.rebuys++;
+		}
+
+		// The buttons the strategy presses, a double, split or surrender the game refuses hits or stands by basic strategy instead
+		Money before = player->GetBalance();
+		frame.Update(InputReset);
+		while (game->GetState() == GameState::Active)
+		{
+			Card upcard = game->GetHand()->GetCards()[0];
+			if (frame.Update(ToInput(strategy(upcard, player->GetHand()))) == FrameSilent)
+			{
+				frame.Update(ToInput(BasicHitStandStrategy(upcard, player->GetHand())));
+			}
+		}
+
+		Money wagered = Money();
+		for (int h = 0; h < player->GetHandCount(); h++)
+		{
+			wagered += player->GetHandBet(h);
+		}
+		stats.rounds++;
+		stats.net += (player->GetBalance() - before).cents;
+		stats.wagered += wagered.cents;
+		if (stats.rounds % stats.bankrollEvery == 0)
+		{
+			SampleBankroll();
+		}
+	} while (Clock::now() < until);
+}
+
+/// <summary>
+/// Adds the balance to the bankroll curve, halving the curve's resolution when it is full.
+/// </summary>
+void LogicThread::SampleBankroll()
+{
+	if (stats.bankrollCount == AutoplayStats::BankrollSamples)
+	{
+		for (int i = 0; i < AutoplayStats::BankrollSamples / 2; i++)
+		{
+			stats.bankroll[i] = stats.bankroll[i * 2 + 1];
+		}
+		stats.bankrollCount = AutoplayStats::BankrollSamples / 2;
+		stats.bankrollEvery *= 2;
+		if (stats.rounds % stats.bankrollEvery != 0)
+		{
+			return;
+		}
+	}
+	stats.bankroll[stats.bankrollCount++] = game->GetPlayer()->GetBalance().cents;
+}
+
+/// <summary>
+/// Copies the table into a snapshot.
+/// </summary>
+/// <param name="snapshot">The snapshot to fill.</param>
+void LogicThread::Capture(TableSnapshot& snapshot)
+{
+	Hand* dealer = game->GetHand();
+	CardView house = dealer->GetCards();
+	std::copy(house.begin(), house.end(), snapshot.dealer);
+	snapshot.dealerCount = house.size();
+	snapshot.dealerScore = dealer->GetScore();
+
+	Player* player = game->GetPlayer();
+	snapshot.handCount = player->GetHandCount();
+	snapshot.active = player->GetActive();
+	for (int h = 0; h < snapshot.handCount; h++)
+	{
+		CardView cards = player->GetHand(h)->GetCards();
+		std::copy(cards.begin(), cards.end(), snapshot.hands[h]);
+		snapshot.cardCounts[h] = cards.size();
+		snapshot.scores[h] = player->GetHand(h)->GetScore();
+	}
+	snapshot.bet = player->GetBet();
+	snapshot.balance = player->GetBalance();
+
+	snapshot.state = game->GetState();
+	snapshot.legal = game->GetLegalActions();
+	snapshot.statusText = frame.GetStatusText();
+	snapshot.dealerRevealed = frame.IsDealerRevealed();
+	snapshot.gameEnd = frame.IsGameEnd();
+	snapshot.version = frame.GetVersion();
+	snapshot.round = frame.GetRound();
+	snapshot.autoplay = stats;
+	snapshot.applied = applied;
+	snapshot.clicks = clicks;
+}
+
+/// <summary>
+/// Sends a press to the game, window thread only.
+/// </summary>
+/// <param name="command">The press.</param>
+/// <returns>False if too many presses are waiting and this one was dropped.</returns>
+bool LogicThread::Push(FrameInput command)
+{
+	return commands.Push(command);
+}
+
+/// <summary>
+/// Gets the newest table, window thread only.
+/// </summary>
+/// <returns>The snapshot, valid until the next call.</returns>
+const TableSnapshot& LogicThread::Acquire()
+{
+	snapshots.Update();
+	return snapshots.GetFront();
+}
@@ -0,0 +1,388 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "frame.hpp"
+#include "game.hpp"
+#include "simulator.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// Game logic on its own thread, talking to the window through lock-free snapshots and commands
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// Running totals of the rounds played by a strategy.
+		/// </summary>
+		struct AutoplayStats
+		{
+			/// <summary>
+			/// The most bankroll samples kept, every other one is dropped when they fill up.
+			/// </summary>
+			static const int BankrollSamples = 256;
+
+			/// <summary>
+			/// Whether the strategy is playing.
+			/// </summary>
+			bool enabled;
+
+			/// <summary>
+			/// Rounds played and times the balance was topped up to keep playing.
+			/// </summary>
+			long long rounds;
+			int rebuys;
+
+			/// <summary>
+			/// Won and wagered over every round, in cents.
+			/// </summary>
+			long long net;
+			long long wagered;
+
+			/// <summary>
+			/// Rounds per second, over the last half second or so.
+			/// </summary>
+			double handsPerSecond;
+
+			/// <summary>
+			/// The balance every <see cref="AutoplayStats::bankrollEvery"/> rounds, oldest first, in cents.
+			/// </summary>
+			long long bankroll[BankrollSamples];
+			int bankrollCount;
+			long long bankrollEvery;
+
+			/// <summary>
+			/// Gets the expected value of a round as a fraction of the amount wagered.
+			/// </summary>
+			/// <returns>The expected value.</returns>
+			double GetEV() const
+			{
+				return wagered > 0 ? (double)net / wagered : 0.0;
+			}
+		};
+
+		/// <summary>
+		/// Everything the window draws, copied out of the game so it can be read while the game moves on.
+		/// </summary>
+		struct TableSnapshot
+		{
+			/// <summary>
+			/// The dealer's cards and score.
+			/// </summary>
+			Card dealer[Hand::MaxCards];
+			int dealerCount;
+			int dealerScore;
+
+			/// <summary>
+			/// The player's hands, their scores and the hand being played.
+			/// </summary>
+			Card hands[Player::MaxHands][Hand::MaxCards];
+			int cardCounts[Player::MaxHands];
+			int scores[Player::MaxHands];
+			int handCount;
+			int active;
+
+			/// <summary>
+			/// The player's money.
+			/// </summary>
+			Money bet;
+			Money balance;
+
+			/// <summary>
+			/// The round's state and the actions it allows.
+			/// </summary>
+			GameState state;
+			ActionSet legal;
+
+			/// <summary>
+			/// What <see cref="Frame"/> shows.
+			/// </summary>
+			const char* statusText;
+			bool dealerRevealed;
+			bool gameEnd;
+
+			/// <summary>
+			/// The <see cref="Frame::GetVersion"/> and <see cref="Frame::GetRound"/> this was taken at.
+			/// </summary>
+			uint32_t version;
+			uint32_t round;
+
+			/// <summary>
+			/// The strategy's totals, when it is or was playing.
+			/// </summary>
+			AutoplayStats autoplay;
+
+			/// <summary>
+			/// Commands applied so far.
+			/// </summary>
+			uint32_t applied;
+
+			/// <summary>
+			/// Clicks asked for so far, the window plays one for each increase.
+			/// </summary>
+			uint32_t clicks;
+
+			/// <summary>
+			/// Gets the dealer's cards.
+			/// </summary>
+			/// <returns>The cards, valid while the snapshot is.</returns>
+			CardView GetDealer() const
+			{
+				return CardView{ dealer, dealerCount };
+			}
+
+			/// <summary>
+			/// Gets one of the player's hands.
+			/// </summary>
+			/// <param name="hand">The hand.</param>
+			/// <returns>The cards, valid while the snapshot is.</returns>
+			CardView GetHand(int hand) const
+			{
+				return CardView{ hands[hand], cardCounts[hand] };
+			}
+		};
+
+		/// <summary>
+		/// A lock-free triple buffer of snapshots, one writer and one reader.
+		/// <para>The writer fills the back slot and swaps it with the middle one, the reader swaps the middle one for its front slot when it is newer.</para>
+		/// <para>Neither side waits for the other, the reader always sees a whole snapshot.</para>
+		/// </summary>
+		class SnapshotBuffer
+		{
+		private:
+			/// <summary>
+			/// Set in <see cref="SnapshotBuffer::middle"/> when the middle slot has not been read.
+			/// </summary>
+			static const uint8_t Fresh = 4;
+
+			/// <summary>
+			/// The three slots.
+			/// </summary>
+			TableSnapshot slots[3];
+
+			/// <summary>
+			/// The slot between the two threads, and whether it is fresh.
+			/// </summary>
+			alignas(64) std::atomic<uint8_t> middle;
+
+			/// <summary>
+			/// The writer's slot.
+			/// </summary>
+			alignas(64) uint8_t back;
+
+			/// <summary>
+			/// The reader's slot.
+			/// </summary>
+			alignas(64) uint8_t front;
+		public:
+			/// <summary>
+			/// Constructor, every slot starts zeroed.
+			/// </summary>
+			SnapshotBuffer();
+
+			/// <summary>
+			/// Gets the slot to write the next snapshot into, writer only.
+			/// </summary>
+			/// <returns>The back slot, which holds an old snapshot.</returns>
+			TableSnapshot& GetBack();
+
+			/// <summary>
+			/// Hands the back slot to the reader, writer only.
+			/// </summary>
+			void Publish();
+
+			/// <summary>
+			/// Takes the newest published snapshot if there is one, reader only.
+			/// </summary>
+			/// <returns>True if the front slot changed.</returns>
+			bool Update();
+
+			/// <summary>
+			/// Gets the newest snapshot taken, reader only.
+			/// </summary>
+			/// <returns>The front slot.</returns>
+			const TableSnapshot& GetFront();
+		};
+
+		/// <summary>
+		/// A lock-free ring of button presses, one producer and one consumer.
+		/// </summary>
+		class CommandQueue
+		{
+		public:
+			/// <summary>
+			/// The most presses waiting at once, a power of two.
+			/// </summary>
+			static const uint32_t Capacity = 64;
+		private:
+			/// <summary>
+			/// The presses.
+			/// </summary>
+			FrameInput commands[Capacity];
+
+			/// <summary>
+			/// Presses pushed and popped so far, each on its own cache line.
+			/// </summary>
+			alignas(64) std::atomic<uint32_t> tail;
+			alignas(64) std::atomic<uint32_t> head;
+		public:
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			CommandQueue();
+
+			/// <summary>
+			/// Adds a press, producer only.
+			/// </summary>
+			/// <param name="command">The press.</param>
+			/// <returns>False if the queue is full and the press was dropped.</returns>
+			bool Push(FrameInput command);
+
+			/// <summary>
+			/// Takes the oldest press, consumer only.
+			/// </summary>
+			/// <param name="command">Receives the press.</param>
+			/// <returns>False if the queue is empty.</returns>
+			bool Pop(FrameInput& command);
+		};
+
+		/// <summary>
+		/// Runs a game and its <see cref="Frame"/> at a fixed timestep on a thread of its own.
+		/// <para>Presses go in through <see cref="LogicThread::Push"/>, the table comes out through <see cref="LogicThread::Acquire"/>, nothing else is shared.</para>
+		/// <para><see cref="InputAutoplay"/> hands the table to a strategy, which plays as fast as it can between snapshots.
+		/// The game's history log is closed when it does, the strategy's rounds are not recorded and a replay needs every round.</para>
+		/// </summary>
+		class LogicThread
+		{
+		public:
+			/// <summary>
+			/// Snapshots published per second while the strategy plays, the window draws no more than these.
+			/// </summary>
+			static constexpr double AutoplayRate = 30.0;
+		private:
+			typedef std::chrono::steady_clock Clock;
+
+			/// <summary>
+			/// The game, only touched by the thread once it runs.
+			/// </summary>
+			RuntimeGame* game;
+
+			/// <summary>
+			/// The window logic driving the game.
+			/// </summary>
+			Frame frame;
+
+			/// <summary>
+			/// The time between updates, in seconds.
+			/// </summary>
+			double step;
+
+			/// <summary>
+			/// The two ways across.
+			/// </summary>
+			SnapshotBuffer snapshots;
+			CommandQueue commands;
+
+			/// <summary>
+			/// Counted by the thread and copied into each snapshot.
+			/// </summary>
+			uint32_t applied;
+			uint32_t clicks;
+
+			/// <summary>
+			/// The strategy that plays in autoplay, and its totals so far.
+			/// </summary>
+			Strategy strategy;
+			AutoplayStats stats;
+
+			/// <summary>
+			/// Plays whole rounds with the strategy until a time.
+			/// </summary>
+			/// <param name="until">When to stop, checked between rounds.</param>
+			void Autoplay(Clock::time_point until);
+
+			/// <summary>
+			/// Adds the balance to the bankroll curve, halving the curve's resolution when it is full.
+			/// </summary>
+			void SampleBankroll();
+
+			/// <summary>
+			/// Cleared to stop the thread.
+			/// </summary>
+			std::atomic<bool> running;
+
+			/// <summary>
+			/// The thread.
+			/// </summary>
+			std::thread thread;
+
+			/// <summary>
+			/// The thread's main loop.
+			/// </summary>
+			void Run();
+
+			/// <summary>
+			/// Copies the table into a snapshot.
+			/// </summary>
+			/// <param name="snapshot">The snapshot to fill.</param>
+			void Capture(TableSnapshot& snapshot);
+		public:
+			/// <summary>
+			/// Constructor, takes the first snapshot and starts the thread.
+			/// </summary>
+			/// <param name="game">The game, already started, which the thread owns until it stops.</param>
+			/// <param name="strategy">The strategy that plays in autoplay.</param>
+			/// <param name="step">The time between updates, in seconds.</param>
+			LogicThread(RuntimeGame* game, Strategy strategy = BasicStrategy, double step = 1.0 / 120.0);
+
+			/// <summary>
+			/// Destructor, stops the thread.
+			/// </summary>
+			~LogicThread();
+
+			LogicThread(const LogicThread&) = delete;
+			LogicThread& operator=(const LogicThread&) = delete;
+
+			/// <summary>
+			/// Sends a press to the game, window thread only.
+			/// </summary>
+			/// <param name="command">The press.</param>
+			/// <returns>False if too many presses are waiting and this one was dropped.</returns>
+			bool Push(FrameInput command);
+
+			/// <summary>
+			/// Gets the newest table, window thread only.
+			/// </summary>
+			/// <returns>The snapshot, valid until the next call.</returns>
+			const TableSnapshot& Acquire();
+		};
+	}
+}
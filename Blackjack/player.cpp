@@ -31,13 +31,165 @@ using namespace KiwifruitDev::Blackjack;
 /// <summary>
 /// Default constructor.
 /// </summary>
-Player::Player(int balance, int bet) : Hand(), bet(bet), balance(balance) {}
+/// <param name="pool">The pool hands are taken from, it must outlive the player.</param>
+Player::Player(HandPool* pool, Money balance, Money bet)
+	: pool(pool), hands(), bets(), handCount(1), active(), bet(bet), balance(balance)
+{
+	hands[0] = pool->Acquire();
+	bets[0] = bet;
+}
+
+/// <summary>
+/// Destructor, returns the hands to the pool.
+/// </summary>
+Player::~Player()
+{
+	for (int i = 0; i < handCount; i++)
+	{
+		pool->Release(hands[i]);
+	}
+}
+
+/// <summary>
+/// Returns to a single empty hand carrying the current bet.
+/// </summary>
+void Player::Reset()
+{
+	// Give split hands back to the pool.
+	for (int i = 1; i < handCount; i++)
+	{
+		pool->Release(hands[i]);
+	}
+	hands[0]->Reset();
+	bets[0] = bet;
+	handCount = 1;
+	active = 0;
+}
+
+/// <summary>
+/// Gets the hand being played.
+/// </summary>
+/// <returns>The hand being played.</returns>
+Hand* Player::GetHand()
+{
+	return hands[active];
+}
+
+/// <summary>
+/// Gets a hand.
+/// </summary>
+/// <param name="index">The index of the hand.</param>
+/// <returns>The hand.</returns>
+Hand* Player::GetHand(int index)
+{
+	return hands[index];
+}
+
+/// <summary>
+/// Gets the number of hands.
+/// </summary>
+/// <returns>The number of hands.</returns>
+int Player::GetHandCount()
+{
+	return handCount;
+}
+
+/// <summary>
+/// Gets the index of the hand being played.
+/// </summary>
+/// <returns>The index of the hand being played.</returns>
+int Player::GetActive()
+{
+	return active;
+}
+
+/// <summary>
+/// Moves on to the next hand.
+/// </summary>
+/// <returns>False if every hand has been played.</returns>
+bool Player::NextHand()
+{
+	if (active + 1 >= handCount)
+	{
+		return false;
+	}
+	active++;
+	return true;
+}
+
+/// <summary>
+/// Gets the bet on a hand.
+/// </summary>
+/// <param name="index">The index of the hand.</param>
+/// <returns>The bet on the hand.</returns>
+Money Player::GetHandBet(int index)
+{
+	return bets[index];
+}
+
+/// <summary>
+/// Gets the total bet across every hand.
+/// </summary>
+/// <returns>The total bet.</returns>
+Money Player::GetTotalBet()
+{
+	Money total = Money();
+	for (int i = 0; i < handCount; i++)
+	{
+		total += bets[i];
+	}
+	return total;
+}
+
+/// <summary>
+/// Checks if the hand being played can be split: it has two cards and there is room for another hand, here and in the pool.
+/// </summary>
+/// <returns>True if <see cref="Player::Split"/> would succeed.</returns>
+bool Player::CanSplit()
+{
+	return handCount < MaxHands && hands[active]->GetCount() == 2 && pool->GetFree() > 0;
+}
+
+/// <summary>
+/// Splits the hand being played, moving its second card to a new hand right after it.
+/// <para>The new hand carries the same bet.</para>
+/// </summary>
+/// <returns>False if there is no room for another hand.</returns>
+bool Player::Split()
+{
+	if (!CanSplit())
+	{
+		return false;
+	}
+	Hand* hand = pool->Acquire();
+
+	// Make room right after the hand being played.
+	for (int i = handCount; i > active + 1; i--)
+	{
+		hands[i] = hands[i - 1];
+		bets[i] = bets[i - 1];
+	}
+	handCount++;
+
+	hand->AddCard(hands[active]->PopCard());
+	hands[active + 1] = hand;
+	bets[active + 1] = bets[active];
+	return true;
+}
+
+/// <summary>
+/// Doubles the bet on the hand being played.
+/// </summary>
+void Player::Double()
+{
+	bets[active] = bets[active] * 2;
+}
 
 /// <summary>
 /// Gets the player's current bet.
 /// </summary>
 /// <returns>The player's current bet.</returns>
-int Player::GetBet()
+Money Player::GetBet()
 {
 	return bet;
 }
@@ -46,7 +198,7 @@ int Player::GetBet()
 /// Gets the player's current balance.
 /// </summary>
 /// <returns>The player's current balance.</returns>
-int Player::GetBalance()
+Money Player::GetBalance()
 {
 	return balance;
 }
@@ -56,10 +208,15 @@ int Player::GetBalance()
 /// </summary>
 /// <param name="bet">The bet to set.</param>
 /// <returns>True if the bet was set, false if the bet is invalid.</returns>
-bool Player::SetBet(int bet)
+bool Player::SetBet(Money bet)
 {
-	if (bet > 0 && bet <= balance)
+	if (bet > Money() && bet <= balance)
 	{
+		// A round in progress follows the bet until it is split or doubled.
+		if (handCount == 1 && bets[0] == this->bet)
+		{
+			bets[0] = bet;
+		}
 		this->bet = bet;
 		return true;
 	}
@@ -70,7 +227,16 @@ bool Player::SetBet(int bet)
 /// Sets the player's current balance.
 /// </summary>
 /// <param name="balance">The balance to set.</param>
-void Player::SetBalance(int balance)
+void Player::SetBalance(Money balance)
 {
 	this->balance = balance;
 }
+
+/// <summary>
+/// Adds to the player's balance, or takes from it when negative.
+/// </summary>
+/// <param name="amount">The amount.</param>
+void Player::Credit(Money amount)
+{
+	balance += amount;
+}
@@ -27,56 +27,170 @@
 #pragma once
 
 #include "hand.hpp"
+#include "ledger.hpp"
 
 namespace KiwifruitDev
 {
 	namespace Blackjack
 	{
 		/// <summary>
-		/// The player.
+		/// The player and their hands.
+		/// <para>Hands come from a <see cref="HandPool"/> owned by the table, splitting never allocates.</para>
 		/// </summary>
-		class Player : public Hand
+		class Player
 		{
+		public:
+			/// <summary>
+			/// The most hands a player can split into.
+			/// </summary>
+			static const int MaxHands = 4;
 		protected:
+			/// <summary>
+			/// The pool hands are taken from.
+			/// </summary>
+			HandPool* pool;
+
+			/// <summary>
+			/// The player's hands, in the order they are played.
+			/// </summary>
+			Hand* hands[MaxHands];
+
+			/// <summary>
+			/// The bet on each hand.
+			/// </summary>
+			Money bets[MaxHands];
+
+			/// <summary>
+			/// The number of hands.
+			/// </summary>
+			int handCount;
+
+			/// <summary>
+			/// The hand being played.
+			/// </summary>
+			int active;
+
 			/// <summary>
 			/// The player's current bet.
 			/// </summary>
-			int bet;
+			Money bet;
 
 			/// <summary>
 			/// The player's current balance.
 			/// </summary>
-			int balance;
+			Money balance;
 		public:
 			/// <summary>
 			/// Default constructor.
 			/// </summary>
-			Player(int balance = 1000, int bet = 10);
+			/// <param name="pool">The pool hands are taken from, it must outlive the player.</param>
+			Player(HandPool* pool, Money balance = Money::FromUnits(1000), Money bet = Money::FromUnits(10));
+
+			/// <summary>
+			/// Destructor, returns the hands to the pool.
+			/// </summary>
+			~Player();
+
+			Player(const Player&) = delete;
+			Player& operator=(const Player&) = delete;
+
+			/// <summary>
+			/// Returns to a single empty hand carrying the current bet.
+			/// </summary>
+			void Reset();
+
+			/// <summary>
+			/// Gets the hand being played.
+			/// </summary>
+			/// <returns>The hand being played.</returns>
+			Hand* GetHand();
+
+			/// <summary>
+			/// Gets a hand.
+			/// </summary>
+			/// <param name="index">The index of the hand.</param>
+			/// <returns>The hand.</returns>
+			Hand* GetHand(int index);
+
+			/// <summary>
+			/// Gets the number of hands.
+			/// </summary>
+			/// <returns>The number of hands.</returns>
+			int GetHandCount();
+
+			/// <summary>
+			/// Gets the index of the hand being played.
+			/// </summary>
+			/// <returns>The index of the hand being played.</returns>
+			int GetActive();
+
+			/// <summary>
+			/// Moves on to the next hand.
+			/// </summary>
+			/// <returns>False if every hand has been played.</returns>
+			bool NextHand();
+
+			/// <summary>
+			/// Gets the bet on a hand.
+			/// </summary>
+			/// <param name="index">The index of the hand.</param>
+			/// <returns>The bet on the hand.</returns>
+			Money GetHandBet(int index);
+
+			/// <summary>
+			/// Gets the total bet across every hand.
+			/// </summary>
+			/// <returns>The total bet.</returns>
+			Money GetTotalBet();
+
+			/// <summary>
+			/// Checks if the hand being played can be split: it has two cards and there is room for another hand, here and in the pool.
+			/// </summary>
+			/// <returns>True if <see cref="Player::Split"/> would succeed.</returns>
+			bool CanSplit();
+
+			/// <summary>
+			/// Splits the hand being played, moving its second card to a new hand right after it.
+			/// <para>The new hand carries the same bet.</para>
+			/// </summary>
+			/// <returns>False if there is no room for another hand, see <see cref="Player::CanSplit"/>.</returns>
+			bool Split();
+
+			/// <summary>
+			/// Doubles the bet on the hand being played.
+			/// </summary>
+			void Double();
 
 			/// <summary>
 			/// Gets the player's current bet.
 			/// </summary>
 			/// <returns>The player's current bet.</returns>
-			int GetBet();
+			Money GetBet();
 
 			/// <summary>
 			/// Gets the player's current balance.
 			/// </summary>
 			/// <returns>The player's current balance.</returns>
-			int GetBalance();
+			Money GetBalance();
 
 			/// <summary>
 			/// Sets the player's current bet.
 			/// </summary>
 			/// <param name="bet">The bet to set.</param>
 			/// <returns>True if the bet was set, false if the bet is invalid.</returns>
-			bool SetBet(int bet);
+			bool SetBet(Money bet);
 
 			/// <summary>
 			/// Sets the player's current balance.
 			/// </summary>
 			/// <param name="balance">The balance to set.</param>
-			void SetBalance(int balance);
+			void SetBalance(Money balance);
+
+			/// <summary>
+			/// Adds to the player's balance, or takes from it when negative.
+			/// </summary>
+			/// <param name="amount">The amount.</param>
+			void Credit(Money amount);
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,256 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "pool.hpp"
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Pins the calling thread to a CPU, where the platform supports it.
+/// </summary>
+/// <param name="cpu">The CPU index.</param>
+static void PinThread(int cpu)
+{
+#ifdef _WIN32
+	SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << (cpu % (sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu % CPU_SETSIZE, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+/// <summary>
+/// Packs a slice.
+/// </summary>
+static uint64_t Pack(uint32_t begin, uint32_t end)
+{
+	return (uint64_t)begin << 32 | end;
+}
+
+/// <summary>
+/// Constructor, starts the worker threads.
+/// </summary>
+/// <param name="threads">The number of workers, 0 for one per hardware thread.</param>
+/// <param name="pin">Pin each worker to its own CPU.</param>
+WorkStealingPool::WorkStealingPool(int threads, bool pin)
+	: slices(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())), task(), generation(), busy(), stopping()
+{
+	for (size_t i = 0; i < slices.size(); i++)
+	{
+		slices[i].range.store(0);
+		this->threads.emplace_back(&WorkStealingPool::WorkerMain, this, (int)i, pin);
+	}
+}
+
+/// <summary>
+/// Destructor, stops the worker threads.
+/// </summary>
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+/// <summary>
+/// The worker thread's main loop.
+/// </summary>
+/// <param name="worker">The worker index.</param>
+/// <param name="pin">Pin the thread to the CPU with the same index.</param>
+void WorkStealingPool::WorkerMain(int worker, bool pin)
+{
+	if (pin)
+	{
+		PinThread(worker);
+	}
+
+	uint64_t seen = 0;
+	while (true)
+	{
+		// Wait for a task
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [&] { return stopping || generation != seen; });
+			if (stopping)
+			{
+				return;
+			}
+			seen = generation;
+		}
+
+		Drain(worker);
+
+		// Report back
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--busy == 0)
+			{
+				done.notify_one();
+			}
+		}
+	}
+}
+
+/// <summary>
+/// Runs indices from the worker's own slice, then steals until nothing is left.
+/// </summary>
+/// <param name="worker">The worker index.</param>
+void WorkStealingPool::Drain(int worker)
+{
+	uint32_t index;
+	do
+	{
+		while (Pop(worker, index))
+		{
+			(*task)(index, worker);
+		}
+	} while (Steal(worker));
+}
+
+/// <summary>
+/// Takes the next index from the front of a worker's own slice.
+/// </summary>
+/// <param name="worker">The worker index.</param>
+/// <param name="index">The index taken.</param>
+/// <returns>False if the slice is empty.</returns>
+bool WorkStealingPool::Pop(int worker, uint32_t& index)
+{
+	std::atomic<uint64_t>& range = slices[worker].range;
+	uint64_t current = range.load(std::memory_order_acquire);
+	while (true)
+	{
+		uint32_t begin = (uint32_t)(current >> 32);
+		uint32_t end = (uint32_t)current;
+		if (begin >= end)
+		{
+			return false;
+		}
+		if (range.compare_exchange_weak(current, Pack(begin + 1, end), std::memory_order_acq_rel))
+		{
+			index = begin;
+			return true;
+		}
+	}
+}
+
+/// <summary>
+/// Moves half of the largest other slice into a worker's own slice.
+/// </summary>
+/// <param name="worker">The worker index.</param>
+/// <returns>False if there was nothing to steal.</returns>
+bool WorkStealingPool::Steal(int worker)
+{
+	while (true)
+	{
+		// Find the victim with the most work left
+		int victim = -1;
+		uint64_t victimRange = 0;
+		uint32_t most = 0;
+		for (int i = 0; i < (int)slices.size(); i++)
+		{
+			if (i == worker)
+			{
+				continue;
+			}
+			uint64_t current = slices[i].range.load(std::memory_order_acquire);
+			uint32_t begin = (uint32_t)(current >> 32);
+			uint32_t end = (uint32_t)current;
+			if (end > begin && end - begin > most)
+			{
+				most = end - begin;
+				victim = i;
+				victimRange = current;
+			}
+		}
+		if (victim < 0)
+		{
+			return false;
+		}
+
+		// Take the back half, rounded up so a single index can be stolen too
+		uint32_t begin = (uint32_t)(victimRange >> 32);
+		uint32_t end = (uint32_t)victimRange;
+		uint32_t split = end - (end - begin + 1) / 2;
+		if (slices[victim].range.compare_exchange_strong(victimRange, Pack(begin, split), std::memory_order_acq_rel))
+		{
+			// Only this worker writes to its own empty slice here, so a plain store is safe
+			slices[worker].range.store(Pack(split, end), std::memory_order_release);
+			return true;
+		}
+	}
+}
+
+/// <summary>
+/// Runs a task for every index in [0, count) and waits for all of them.
+/// </summary>
+/// <param name="count">The number of indices.</param>
+/// <param name="task">The task.</param>
+void WorkStealingPool::ForEach(uint32_t count, const Task& task)
+{
+	// Split the indices evenly to start with
+	uint32_t workers = (uint32_t)slices.size();
+	for (uint32_t i = 0; i < workers; i++)
+	{
+		uint32_t begin = (uint32_t)((uint64_t)count * i / workers);
+		uint32_t end = (uint32_t)((uint64_t)count * (i + 1) / workers);
+		slices[i].range.store(Pack(begin, end), std::memory_order_relaxed);
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	this->task = &task;
+	busy = (int)workers;
+	generation++;
+	wake.notify_all();
+	done.wait(lock, [&] { return busy == 0; });
+	this->task = nullptr;
+}
+
+/// <summary>
+/// Gets the number of workers.
+/// </summary>
+/// <returns>The number of workers.</returns>
+int WorkStealingPool::GetThreadCount()
+{
+	return (int)threads.size();
+}
@@ -0,0 +1,165 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// A fixed set of worker threads that run indexed tasks with work stealing.
+		/// <para>Each worker starts with an even slice of the indices and takes from its front.</para>
+		/// <para>A worker that runs out steals half of the largest remaining slice from its back.</para>
+		/// </summary>
+		class WorkStealingPool
+		{
+		public:
+			/// <summary>
+			/// A task, called once per index with the index and the worker running it.
+			/// </summary>
+			typedef std::function<void(uint32_t index, int worker)> Task;
+		private:
+			/// <summary>
+			/// A worker's remaining indices, packed as (begin &lt;&lt; 32 | end) so both ends move atomically.
+			/// <para>Padded to a cache line so workers do not share lines.</para>
+			/// </summary>
+			struct alignas(64) Slice
+			{
+				std::atomic<uint64_t> range;
+			};
+
+			/// <summary>
+			/// The worker threads.
+			/// </summary>
+			std::vector<std::thread> threads;
+
+			/// <summary>
+			/// One slice per worker.
+			/// </summary>
+			std::vector<Slice> slices;
+
+			/// <summary>
+			/// The task being run.
+			/// </summary>
+			const Task* task;
+
+			/// <summary>
+			/// Incremented for every call to <see cref="WorkStealingPool::ForEach"/>, wakes the workers.
+			/// </summary>
+			uint64_t generation;
+
+			/// <summary>
+			/// Workers still running the current task.
+			/// </summary>
+			int busy;
+
+			/// <summary>
+			/// Set when the pool is destroyed.
+			/// </summary>
+			bool stopping;
+
+			/// <summary>
+			/// Guards the fields above, only taken to start and finish a task.
+			/// </summary>
+			std::mutex mutex;
+
+			/// <summary>
+			/// Signalled when a task starts or the pool stops.
+			/// </summary>
+			std::condition_variable wake;
+
+			/// <summary>
+			/// Signalled when the last worker finishes a task.
+			/// </summary>
+			std::condition_variable done;
+
+			/// <summary>
+			/// The worker thread's main loop.
+			/// </summary>
+			/// <param name="worker">The worker index.</param>
+			/// <param name="pin">Pin the thread to the CPU with the same index.</param>
+			void WorkerMain(int worker, bool pin);
+
+			/// <summary>
+			/// Runs indices from the worker's own slice, then steals until nothing is left.
+			/// </summary>
+			/// <param name="worker">The worker index.</param>
+			void Drain(int worker);
+
+			/// <summary>
+			/// Takes the next index from the front of a worker's own slice.
+			/// </summary>
+			/// <param name="worker">The worker index.</param>
+			/// <param name="index">The index taken.</param>
+			/// <returns>False if the slice is empty.</returns>
+			bool Pop(int worker, uint32_t& index);
+
+			/// <summary>
+			/// Moves half of the largest other slice into a worker's own slice.
+			/// </summary>
+			/// <param name="worker">The worker index.</param>
+			/// <returns>False if there was nothing to steal.</returns>
+			bool Steal(int worker);
+		public:
+			/// <summary>
+			/// Constructor, starts the worker threads.
+			/// </summary>
+			/// <param name="threads">The number of workers, 0 for one per hardware thread.</param>
+			/// <param name="pin">Pin each worker to its own CPU.</param>
+			WorkStealingPool(int threads = 0, bool pin = false);
+
+			/// <summary>
+			/// Destructor, stops the worker threads.
+			/// </summary>
+			~WorkStealingPool();
+
+			WorkStealingPool(const WorkStealingPool&) = delete;
+			WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+			/// <summary>
+			/// Runs a task for every index in [0, count) and waits for all of them.
+			/// </summary>
+			/// <param name="count">The number of indices.</param>
+			/// <param name="task">The task.</param>
+			void ForEach(uint32_t count, const Task& task);
+
+			/// <summary>
+			/// Gets the number of workers.
+			/// </summary>
+			/// <returns>The number of workers.</returns>
+			int GetThreadCount();
+		};
+	}
+}
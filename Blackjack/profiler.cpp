@@ -0,0 +1,199 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Constructor.
+/// </summary>
+Profiler::Profiler()
+	: origin(Clock::now()), events(new ProfileEvent[EventCapacity]), eventCount(), openNames(), openStarts(), openZones(), depth(),
+	frameTimes(), frameCount(), frameStart(-1), zones(), zoneCount() {}
+
+/// <summary>
+/// Destructor.
+/// </summary>
+Profiler::~Profiler()
+{
+	delete[] events;
+}
+
+/// <summary>
+/// Gets the time since the profiler was created.
+/// </summary>
+/// <returns>The time in nanoseconds.</returns>
+int64_t Profiler::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count();
+}
+
+/// <summary>
+/// Marks the start of a frame, and the end of the one before it.
+/// </summary>
+void Profiler::BeginFrame()
+{
+	int64_t now = Now();
+	if (frameStart >= 0)
+	{
+		frameTimes[frameCount % FrameCapacity] = now - frameStart;
+		frameCount++;
+	}
+	frameStart = now;
+}
+
+/// <summary>
+/// Begins a zone, nested in any zone already open.
+/// </summary>
+/// <param name="name">The zone's name, which must outlive the profiler.</param>
+void Profiler::Begin(const char* name)
+{
+	if (depth < MaxDepth)
+	{
+		// Zones are few and named by literals, so the pointer finds the average.
+		int zone = 0;
+		while (zone < zoneCount && zones[zone].name != name)
+		{
+			zone++;
+		}
+		if (zone == zoneCount && zoneCount < MaxZones)
+		{
+			zones[zoneCount++] = ZoneStats{ name, depth, -1.0 };
+		}
+		openNames[depth] = name;
+		openZones[depth] = zone;
+		openStarts[depth] = Now();
+	}
+	depth++;
+}
+
+/// <summary>
+/// Ends the innermost open zone.
+/// </summary>
+void Profiler::End()
+{
+	if (depth <= 0)
+	{
+		return;
+	}
+	depth--;
+	if (depth >= MaxDepth)
+	{
+		return;
+	}
+
+	ProfileEvent& event = events[eventCount % EventCapacity];
+	event.name = openNames[depth];
+	event.start = openStarts[depth];
+	event.duration = Now() - event.start;
+	event.depth = depth;
+	eventCount++;
+
+	int zone = openZones[depth];
+	if (zone < zoneCount)
+	{
+		double milliseconds = event.duration / 1e6;
+		zones[zone].average = zones[zone].average < 0.0 ? milliseconds : zones[zone].average + (milliseconds - zones[zone].average) * 0.05;
+	}
+}
+
+/// <summary>
+/// Gets frame time percentiles over the recorded frames.
+/// </summary>
+/// <returns>The percentiles.</returns>
+FrameStats Profiler::GetFrameStats()
+{
+	FrameStats stats = {};
+	int count = (int)std::min<int64_t>(frameCount, FrameCapacity);
+	if (count == 0)
+	{
+		return stats;
+	}
+	int64_t sorted[FrameCapacity];
+	std::copy(frameTimes, frameTimes + count, sorted);
+	std::sort(sorted, sorted + count);
+	auto at = [&](double percentile) { return sorted[std::min(count - 1, (int)(percentile * count))] / 1e6; };
+	stats.frames = count;
+	stats.p50 = at(0.50);
+	stats.p90 = at(0.90);
+	stats.p99 = at(0.99);
+	stats.max = sorted[count - 1] / 1e6;
+	return stats;
+}
+
+/// <summary>
+/// Gets the running averages of every zone seen, in the order they first began.
+/// </summary>
+/// <param name="count">Receives the number of zones.</param>
+/// <returns>The zones.</returns>
+const Profiler::ZoneStats* Profiler::GetZones(int& count)
+{
+	count = zoneCount;
+	return zones;
+}
+
+/// <summary>
+/// Gets a recent frame time.
+/// </summary>
+/// <param name="age">0 for the last finished frame, up to <see cref="Profiler::FrameCapacity"/> - 1.</param>
+/// <returns>The frame time in milliseconds, 0 if there is no such frame.</returns>
+double Profiler::GetFrameTime(int age)
+{
+	if (age < 0 || age >= FrameCapacity || age >= frameCount)
+	{
+		return 0.0;
+	}
+	return frameTimes[(frameCount - 1 - age) % FrameCapacity] / 1e6;
+}
+
+/// <summary>
+/// Writes the recorded zones as Chrome trace JSON, for chrome://tracing or Perfetto.
+/// </summary>
+/// <param name="path">The path of the trace.</param>
+/// <returns>False if the file could not be written.</returns>
+bool Profiler::ExportTrace(const char* path)
+{
+	FILE* file = fopen(path, "w");
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	// Complete events, times in microseconds, oldest first.
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	int64_t first = std::max<int64_t>(0, eventCount - EventCapacity);
+	for (int64_t i = first; i < eventCount; i++)
+	{
+		const ProfileEvent& event = events[i % EventCapacity];
+		fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}\n",
+			i == first ? "" : ",", event.name, event.start / 1e3, event.duration / 1e3);
+	}
+	fprintf(file, "]}\n");
+	return fclose(file) == 0;
+}
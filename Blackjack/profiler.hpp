@@ -0,0 +1,232 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Frame profiler, scoped zones recorded into a ring buffer and exported as a Chrome trace
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// One finished zone.
+		/// </summary>
+		struct ProfileEvent
+		{
+			/// <summary>
+			/// The zone's name, a string literal.
+			/// </summary>
+			const char* name;
+
+			/// <summary>
+			/// When the zone started and how long it took, in nanoseconds since the profiler was created.
+			/// </summary>
+			int64_t start;
+			int64_t duration;
+
+			/// <summary>
+			/// How many zones it is nested in.
+			/// </summary>
+			int depth;
+		};
+
+		/// <summary>
+		/// Frame time percentiles over the recorded frames, in milliseconds.
+		/// </summary>
+		struct FrameStats
+		{
+			int frames;
+			double p50;
+			double p90;
+			double p99;
+			double max;
+		};
+
+		/// <summary>
+		/// Times frames and named zones within them.
+		/// <para>Nothing allocates once constructed, recording a zone is two clock reads and a few stores.</para>
+		/// </summary>
+		class Profiler
+		{
+		public:
+			/// <summary>
+			/// The number of zones kept for the trace, the oldest are overwritten.
+			/// </summary>
+			static const int EventCapacity = 1 << 16;
+
+			/// <summary>
+			/// The number of frame times kept for the percentiles.
+			/// </summary>
+			static const int FrameCapacity = 600;
+
+			/// <summary>
+			/// The most distinct zones averaged for the overlay, and the deepest they nest.
+			/// </summary>
+			static const int MaxZones = 32;
+			static const int MaxDepth = 16;
+
+			/// <summary>
+			/// A zone's running average in milliseconds, for the overlay, negative until the zone first ends.
+			/// </summary>
+			struct ZoneStats
+			{
+				const char* name;
+				int depth;
+				double average;
+			};
+		private:
+			typedef std::chrono::steady_clock Clock;
+
+			/// <summary>
+			/// When the profiler was created, every time is relative to this.
+			/// </summary>
+			Clock::time_point origin;
+
+			/// <summary>
+			/// Recorded zones, a ring buffer.
+			/// </summary>
+			ProfileEvent* events;
+			int64_t eventCount;
+
+			/// <summary>
+			/// Zones that have begun and not ended.
+			/// </summary>
+			const char* openNames[MaxDepth];
+			int64_t openStarts[MaxDepth];
+			int openZones[MaxDepth];
+			int depth;
+
+			/// <summary>
+			/// Recent frame times in nanoseconds, a ring buffer.
+			/// </summary>
+			int64_t frameTimes[FrameCapacity];
+			int64_t frameCount;
+			int64_t frameStart;
+
+			/// <summary>
+			/// Averages per zone name, in milliseconds.
+			/// </summary>
+			ZoneStats zones[MaxZones];
+			int zoneCount;
+
+			/// <summary>
+			/// Gets the time since the profiler was created.
+			/// </summary>
+			/// <returns>The time in nanoseconds.</returns>
+			int64_t Now();
+		public:
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			Profiler();
+
+			/// <summary>
+			/// Destructor.
+			/// </summary>
+			~Profiler();
+
+			Profiler(const Profiler&) = delete;
+			Profiler& operator=(const Profiler&) = delete;
+
+			/// <summary>
+			/// Marks the start of a frame, and the end of the one before it.
+			/// </summary>
+			void BeginFrame();
+
+			/// <summary>
+			/// Begins a zone, nested in any zone already open.
+			/// </summary>
+			/// <param name="name">The zone's name, which must outlive the profiler.</param>
+			void Begin(const char* name);
+
+			/// <summary>
+			/// Ends the innermost open zone.
+			/// </summary>
+			void End();
+
+			/// <summary>
+			/// Gets frame time percentiles over the recorded frames.
+			/// </summary>
+			/// <returns>The percentiles.</returns>
+			FrameStats GetFrameStats();
+
+			/// <summary>
+			/// Gets the running averages of every zone seen, in the order they first began.
+			/// </summary>
+			/// <param name="count">Receives the number of zones.</param>
+			/// <returns>The zones.</returns>
+			const ZoneStats* GetZones(int& count);
+
+			/// <summary>
+			/// Gets a recent frame time.
+			/// </summary>
+			/// <param name="age">0 for the last finished frame, up to <see cref="Profiler::FrameCapacity"/> - 1.</param>
+			/// <returns>The frame time in milliseconds, 0 if there is no such frame.</returns>
+			double GetFrameTime(int age);
+
+			/// <summary>
+			/// Writes the recorded zones as Chrome trace JSON, for chrome://tracing or Perfetto.
+			/// </summary>
+			/// <param name="path">The path of the trace.</param>
+			/// <returns>False if the file could not be written.</returns>
+			bool ExportTrace(const char* path);
+		};
+
+		/// <summary>
+		/// Profiles the scope it lives in.
+		/// </summary>
+		class ProfileZone
+		{
+		private:
+			Profiler& profiler;
+		public:
+			/// <summary>
+			/// Begins the zone.
+			/// </summary>
+			/// <param name="profiler">The profiler.</param>
+			/// <param name="name">The zone's name, a string literal.</param>
+			ProfileZone(Profiler& profiler, const char* name) : profiler(profiler)
+			{
+				profiler.Begin(name);
+			}
+
+			/// <summary>
+			/// Ends the zone.
+			/// </summary>
+			~ProfileZone()
+			{
+				profiler.End();
+			}
+
+			ProfileZone(const ProfileZone&) = delete;
+			ProfileZone& operator=(const ProfileZone&) = delete;
+		};
+	}
+}
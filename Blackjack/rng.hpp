@@ -0,0 +1,205 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+// Random number generators
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// SplitMix64, used to expand a single seed into generator state.
+		/// </summary>
+		/// <param name="state">The state, advanced on every call.</param>
+		/// <returns>The next random number.</returns>
+		inline uint64_t SplitMix64(uint64_t& state)
+		{
+			uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		/// <summary>
+		/// xoshiro256** by David Blackman and Sebastiano Vigna.
+		/// <para>32 bytes of state and a few cycles per number, compared to 5 KB for std::mt19937.</para>
+		/// <para>Satisfies UniformRandomBitGenerator, so it works with the standard library.</para>
+		/// </summary>
+		class Xoshiro256
+		{
+		private:
+			/// <summary>
+			/// The generator state, never all zero.
+			/// </summary>
+			uint64_t s[4];
+
+			/// <summary>
+			/// Rotate left.
+			/// </summary>
+			static uint64_t Rotl(uint64_t x, int k)
+			{
+				return (x << k) | (x >> (64 - k));
+			}
+
+			/// <summary>
+			/// Advance the state by a polynomial, used by the jump functions.
+			/// </summary>
+			void Advance(const uint64_t (&polynomial)[4])
+			{
+				uint64_t t[4] = {};
+				for (int i = 0; i < 4; i++)
+				{
+					for (int b = 0; b < 64; b++)
+					{
+						if (polynomial[i] & (1ull << b))
+						{
+							t[0] ^= s[0];
+							t[1] ^= s[1];
+							t[2] ^= s[2];
+							t[3] ^= s[3];
+						}
+						(*this)();
+					}
+				}
+				s[0] = t[0];
+				s[1] = t[1];
+				s[2] = t[2];
+				s[3] = t[3];
+			}
+		public:
+			typedef uint64_t result_type;
+
+			static constexpr result_type min()
+			{
+				return 0;
+			}
+
+			static constexpr result_type max()
+			{
+				return UINT64_MAX;
+			}
+
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			/// <param name="seed">The seed.</param>
+			explicit Xoshiro256(uint64_t seed = 0)
+			{
+				this->seed(seed);
+			}
+
+			/// <summary>
+			/// Seeds the generator.
+			/// <para>Lower case to match the standard library generators.</para>
+			/// </summary>
+			/// <param name="seed">The seed.</param>
+			void seed(uint64_t seed)
+			{
+				s[0] = SplitMix64(seed);
+				s[1] = SplitMix64(seed);
+				s[2] = SplitMix64(seed);
+				s[3] = SplitMix64(seed);
+			}
+
+			/// <summary>
+			/// Gets the next random number.
+			/// </summary>
+			result_type operator()()
+			{
+				uint64_t result = Rotl(s[1] * 5, 7) * 9;
+				uint64_t t = s[1] << 17;
+				s[2] ^= s[0];
+				s[3] ^= s[1];
+				s[1] ^= s[2];
+				s[0] ^= s[3];
+				s[2] ^= t;
+				s[3] = Rotl(s[3], 45);
+				return result;
+			}
+
+			/// <summary>
+			/// Advances the generator by 2^128 numbers.
+			/// <para>Generators jumped a different number of times from the same seed never overlap.</para>
+			/// </summary>
+			void Jump()
+			{
+				static const uint64_t polynomial[4] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+				Advance(polynomial);
+			}
+
+			/// <summary>
+			/// Creates the generator for an independent stream.
+			/// <para>Stream n is the seeded generator jumped n times, so streams are reproducible and never overlap.</para>
+			/// </summary>
+			/// <param name="seed">The seed shared by all streams.</param>
+			/// <param name="stream">The stream index.</param>
+			/// <returns>The generator.</returns>
+			static Xoshiro256 Stream(uint64_t seed, uint64_t stream)
+			{
+				Xoshiro256 rng(seed);
+				for (uint64_t i = 0; i < stream; i++)
+				{
+					rng.Jump();
+				}
+				return rng;
+			}
+		};
+
+		/// <summary>
+		/// Draws an unbiased random number in [0, range) without a division in the common case.
+		/// <para>Lemire's multiply-shift method with rejection.</para>
+		/// </summary>
+		/// <param name="rng">The generator, must produce at least 32 random bits.</param>
+		/// <param name="range">The number of possible results, must not be 0.</param>
+		/// <returns>The random number.</returns>
+		template <typename Random>
+		inline uint32_t Bounded(Random& rng, uint32_t range)
+		{
+			// Use the high bits of 64 bit generators, they are the strongest.
+			uint64_t bits = rng() - Random::min();
+			uint32_t x = (uint32_t)(Random::max() - Random::min() > 0xFFFFFFFFull ? bits >> 32 : bits);
+			uint64_t m = (uint64_t)x * range;
+			uint32_t low = (uint32_t)m;
+			if (low < range)
+			{
+				uint32_t threshold = (0u - range) % range;
+				while (low < threshold)
+				{
+					bits = rng() - Random::min();
+					x = (uint32_t)(Random::max() - Random::min() > 0xFFFFFFFFull ? bits >> 32 : bits);
+					m = (uint64_t)x * range;
+					low = (uint32_t)m;
+				}
+			}
+			return (uint32_t)(m >> 32);
+		}
+	}
+}
@@ -0,0 +1,118 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+// Table rules
+// Both rule types expose the same members, so game code reads rules.hitSoft17 either way.
+// FixedRules makes every flag a compile time constant, so a game built with it has no branches on rule flags.
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// Rules fixed at compile time.
+		/// <para>The deck count only sizes the shoe, so it can still be changed at construction.</para>
+		/// </summary>
+		/// <typeparam name="HitSoft17">The dealer hits soft 17 (H17) instead of standing (S17).</typeparam>
+		/// <typeparam name="BlackjackNumerator">Numerator of the natural blackjack payout.</typeparam>
+		/// <typeparam name="BlackjackDenominator">Denominator of the natural blackjack payout.</typeparam>
+		/// <typeparam name="DoubleAfterSplit">The player may double after splitting.</typeparam>
+		/// <typeparam name="MaxHands">The most hands a player may split into, 1 disallows splitting.</typeparam>
+		/// <typeparam name="LateSurrender">The player may surrender their first two cards for half the bet.</typeparam>
+		/// <typeparam name="Decks">The default number of decks.</typeparam>
+		template <bool HitSoft17, int BlackjackNumerator, int BlackjackDenominator, bool DoubleAfterSplit, int MaxHands, bool LateSurrender, int Decks>
+		struct FixedRules
+		{
+			static constexpr bool hitSoft17 = HitSoft17;
+			static constexpr int blackjackNumerator = BlackjackNumerator;
+			static constexpr int blackjackDenominator = BlackjackDenominator;
+			static constexpr bool doubleAfterSplit = DoubleAfterSplit;
+			static constexpr int maxHands = MaxHands;
+			static constexpr bool lateSurrender = LateSurrender;
+
+			/// <summary>
+			/// The number of decks in the shoe.
+			/// </summary>
+			int decks;
+
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			/// <param name="decks">The number of decks in the shoe.</param>
+			explicit FixedRules(int decks = Decks) : decks(decks) {}
+		};
+
+		/// <summary>
+		/// S17, blackjack pays 3:2, double after split, split to 4 hands, late surrender, 6 decks.
+		/// </summary>
+		typedef FixedRules<false, 3, 2, true, 4, true, 6> StandardRules;
+
+		/// <summary>
+		/// H17, blackjack pays 6:5, no double after split, no resplitting, no surrender, 6 decks.
+		/// </summary>
+		typedef FixedRules<true, 6, 5, false, 2, false, 6> SixFiveRules;
+
+		/// <summary>
+		/// Rules chosen at runtime, for the window.
+		/// <para>Defaults to <see cref="StandardRules"/>.</para>
+		/// </summary>
+		struct RuntimeRules
+		{
+			/// <summary>
+			/// The dealer hits soft 17 (H17) instead of standing (S17).
+			/// </summary>
+			bool hitSoft17 = false;
+
+			/// <summary>
+			/// The natural blackjack payout, numerator and denominator.
+			/// </summary>
+			int blackjackNumerator = 3;
+			int blackjackDenominator = 2;
+
+			/// <summary>
+			/// The player may double after splitting.
+			/// </summary>
+			bool doubleAfterSplit = true;
+
+			/// <summary>
+			/// The most hands a player may split into, 1 disallows splitting.
+			/// </summary>
+			int maxHands = 4;
+
+			/// <summary>
+			/// The player may surrender their first two cards for half the bet.
+			/// </summary>
+			bool lateSurrender = true;
+
+			/// <summary>
+			/// The number of decks in the shoe.
+			/// </summary>
+			int decks = 6;
+		};
+	}
+}
@@ -0,0 +1,97 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "shoe.hpp"
+#include <algorithm>
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Constructor.
+/// <para>The shoe must be shuffled before it is dealt from.</para>
+/// </summary>
+/// <param name="decks">The number of decks, from 1 to <see cref="Shoe::MaxDecks"/>.</param>
+/// <param name="penetration">The fraction of the shoe dealt before the cut card is reached.</param>
+Shoe::Shoe(int decks, float penetration) : decks(std::min(std::max(decks, 1), MaxDecks)), cursor(), remaining()
+{
+	size = this->decks * 52;
+	cutCard = std::min(std::max((int)(size * penetration), 1), size);
+	Gather();
+	cursor = size;
+}
+
+/// <summary>
+/// Puts every card back in the shoe, in a fixed order.
+/// <para>Shuffling always starts from this order, so a shuffle depends only on the generator.</para>
+/// </summary>
+void Shoe::Gather()
+{
+	// Fill the shoe with every card of every deck.
+	int index = 0;
+	for (int deck = 0; deck < decks; deck++)
+	{
+		for (int i = 0; i < 13; i++)
+		{
+			cards[index++] = Card((CardValue)i, CardSuit::CLUBS);
+			cards[index++] = Card((CardValue)i, CardSuit::DIAMONDS);
+			cards[index++] = Card((CardValue)i, CardSuit::HEARTS);
+			cards[index++] = Card((CardValue)i, CardSuit::SPADES);
+		}
+	}
+	cursor = 0;
+	for (int i = 0; i < 13; i++)
+	{
+		remaining[i] = decks * 4;
+	}
+}
+
+/// <summary>
+/// Gets the number of decks in the shoe.
+/// </summary>
+/// <returns>The number of decks.</returns>
+int Shoe::GetDecks()
+{
+	return decks;
+}
+
+/// <summary>
+/// Gets the number of cards left in the shoe.
+/// </summary>
+/// <returns>The number of cards left.</returns>
+int Shoe::GetRemaining()
+{
+	return size - cursor;
+}
+
+/// <summary>
+/// Gets the number of cards of a value left in the shoe.
+/// </summary>
+/// <param name="value">The card value.</param>
+/// <returns>The number of cards left.</returns>
+int Shoe::GetRemaining(CardValue value)
+{
+	return remaining[value];
+}
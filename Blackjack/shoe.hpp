@@ -0,0 +1,200 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "cards.hpp"
+#include "rng.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// A multi-deck shoe.
+		/// <para>Cards are shuffled once and then dealt in order from a cursor, so drawing never moves or allocates memory.</para>
+		/// </summary>
+		class Shoe
+		{
+		public:
+			/// <summary>
+			/// The largest number of decks a shoe can hold.
+			/// </summary>
+			static constexpr int MaxDecks = 8;
+
+			/// <summary>
+			/// The largest number of cards a shoe can hold.
+			/// </summary>
+			static const int MaxCards = MaxDecks * 52;
+		private:
+			/// <summary>
+			/// The cards in the shoe, in dealing order.
+			/// <para>Only the first <see cref="Shoe::size"/> cards are used.</para>
+			/// </summary>
+			Card cards[MaxCards];
+
+			/// <summary>
+			/// The number of decks in the shoe.
+			/// </summary>
+			int decks;
+
+			/// <summary>
+			/// The number of cards in the shoe.
+			/// </summary>
+			int size;
+
+			/// <summary>
+			/// The index of the next card to deal.
+			/// </summary>
+			int cursor;
+
+			/// <summary>
+			/// The index of the cut card.
+			/// <para>Once the cursor passes this point, the shoe should be shuffled before the next round.</para>
+			/// </summary>
+			int cutCard;
+
+			/// <summary>
+			/// The number of cards of each value left in the shoe.
+			/// </summary>
+			int remaining[13];
+
+			/// <summary>
+			/// Puts every card back in the shoe, in a fixed order.
+			/// <para>Shuffling always starts from this order, so a shuffle depends only on the generator.</para>
+			/// </summary>
+			void Gather();
+		public:
+			/// <summary>
+			/// Constructor.
+			/// <para>The shoe must be shuffled before it is dealt from.</para>
+			/// </summary>
+			/// <param name="decks">The number of decks, from 1 to <see cref="Shoe::MaxDecks"/>.</param>
+			/// <param name="penetration">The fraction of the shoe dealt before the cut card is reached.</param>
+			Shoe(int decks = 1, float penetration = 0.75f);
+
+			/// <summary>
+			/// Gathers every card back into the shoe and shuffles it.
+			/// </summary>
+			/// <param name="rng">The random number generator to shuffle with.</param>
+			template <typename Random>
+			void Shuffle(Random& rng)
+			{
+				Gather();
+				// Fisher-Yates, with an unbiased bounded draw for each swap.
+				for (int i = size - 1; i > 0; i--)
+				{
+					std::swap(cards[i], cards[Bounded(rng, (uint32_t)i + 1)]);
+				}
+			}
+
+			/// <summary>
+			/// Shuffles the cards already dealt back in, except the last few which are still on the table.
+			/// <para>For a shoe that runs out in the middle of a round. If every card is on the table, they all go back in.</para>
+			/// </summary>
+			/// <param name="rng">The random number generator to shuffle with.</param>
+			/// <param name="inPlay">The number of cards last dealt that are still on the table.</param>
+			/// <returns>The number of cards left out.</returns>
+			template <typename Random>
+			int Reshuffle(Random& rng, int inPlay)
+			{
+				if (inPlay >= cursor || inPlay >= size)
+				{
+					Shuffle(rng);
+					return 0;
+				}
+
+				// The cards on the table move to the front as if dealt first, the rest are shuffled behind them.
+				std::rotate(cards, cards + cursor - inPlay, cards + cursor);
+				cursor = inPlay;
+				for (int i = 0; i < 13; i++)
+				{
+					remaining[i] = 0;
+				}
+				for (int i = cursor; i < size; i++)
+				{
+					remaining[cards[i].GetRank()]++;
+				}
+				for (int i = size - 1; i > cursor; i--)
+				{
+					std::swap(cards[i], cards[cursor + Bounded(rng, (uint32_t)(i - cursor) + 1)]);
+				}
+				return inPlay;
+			}
+
+			/// <summary>
+			/// Deals the next card from the shoe.
+			/// <para>The shoe must not be empty.</para>
+			/// </summary>
+			/// <returns>The card.</returns>
+			Card Draw()
+			{
+				Card card = cards[cursor++];
+				remaining[card.GetRank()]--;
+				return card;
+			}
+
+			/// <summary>
+			/// Checks if every card has been dealt.
+			/// </summary>
+			/// <returns>True if the shoe is empty.</returns>
+			bool IsEmpty()
+			{
+				return cursor >= size;
+			}
+
+			/// <summary>
+			/// Checks if the cut card has been reached.
+			/// </summary>
+			/// <returns>True if the shoe should be shuffled before the next round.</returns>
+			bool NeedsShuffle()
+			{
+				return cursor >= cutCard;
+			}
+
+			/// <summary>
+			/// Gets the number of decks in the shoe.
+			/// </summary>
+			/// <returns>The number of decks.</returns>
+			int GetDecks();
+
+			/// <summary>
+			/// Gets the number of cards left in the shoe.
+			/// </summary>
+			/// <returns>The number of cards left.</returns>
+			int GetRemaining();
+
+			/// <summary>
+			/// Gets the number of cards of a value left in the shoe.
+			/// </summary>
+			/// <param name="value">The card value.</param>
+			/// <returns>The number of cards left.</returns>
+			int GetRemaining(CardValue value);
+		};
+	}
+}
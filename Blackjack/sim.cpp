@@ -0,0 +1,418 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "batch.hpp"
+#include "dealer.hpp"
+#include "history.hpp"
+#include "simulator.hpp"
+#include "table.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+
+using namespace KiwifruitDev::Blackjack;
+
+// Headless simulator executable
+// Usage: Simulator [--rounds n] [--strategy stand|dealer|safe|basic] [--decks n] [--seed n] [--trajectory file.csv]
+//                  [--threads n] [--pin] [--scaling] [--batch] [--dealer]
+//                  [--seats n] [--audit] [--record file.bjh] [--replay file.bjh]
+
+// Formats an amount in cents as units and cents
+static const char* FormatMoney(long long cents, char (&buffer)[32])
+{
+	unsigned long long magnitude = cents < 0 ? 0ull - (unsigned long long)cents : (unsigned long long)cents;
+	snprintf(buffer, sizeof(buffer), "%s%llu.%02llu", cents < 0 ? "-" : "", magnitude / 100, magnitude % 100);
+	return buffer;
+}
+
+int main(int argc, char** argv)
+{
+	long long rounds = 1000000;
+	const char* strategyName = "dealer";
+	int decks = 6;
+	uint64_t seed = (uint64_t)std::random_device()() << 32 | std::random_device()();
+	const char* trajectoryPath = nullptr;
+	const char* recordPath = nullptr;
+	const char* replayPath = nullptr;
+	int threads = 0;
+	int seats = 0;
+	bool pin = false;
+	bool scaling = false;
+	bool batch = false;
+	bool dealer = false;
+	bool audit = false;
+
+	// Parse options
+	for (int i = 1; i < argc; i++)
+	{
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		if (strcmp(argv[i], "--pin") == 0)
+		{
+			pin = true;
+			continue;
+		}
+		else if (strcmp(argv[i], "--scaling") == 0)
+		{
+			scaling = true;
+			continue;
+		}
+		else if (strcmp(argv[i], "--batch") == 0)
+		{
+			batch = true;
+			continue;
+		}
+		else if (strcmp(argv[i], "--audit") == 0)
+		{
+			audit = true;
+			continue;
+		}
+		else if (strcmp(argv[i], "--dealer") == 0)
+		{
+			dealer = true;
+			continue;
+		}
+		else if (value == nullptr)
+		{
+			fprintf(stderr, "Missing value for \"%s\".\n", argv[i]);
+			return 1;
+		}
+		else if (strcmp(argv[i], "--rounds") == 0)
+		{
+			rounds = atoll(value);
+		}
+		else if (strcmp(argv[i], "--strategy") == 0)
+		{
+			strategyName = value;
+		}
+		else if (strcmp(argv[i], "--decks") == 0)
+		{
+			decks = atoi(value);
+		}
+		else if (strcmp(argv[i], "--seed") == 0)
+		{
+			seed = strtoull(value, nullptr, 0);
+		}
+		else if (strcmp(argv[i], "--trajectory") == 0)
+		{
+			trajectoryPath = value;
+		}
+		else if (strcmp(argv[i], "--record") == 0)
+		{
+			recordPath = value;
+		}
+		else if (strcmp(argv[i], "--replay") == 0)
+		{
+			replayPath = value;
+		}
+		else if (strcmp(argv[i], "--threads") == 0)
+		{
+			threads = atoi(value);
+		}
+		else if (strcmp(argv[i], "--seats") == 0)
+		{
+			seats = atoi(value);
+		}
+		else
+		{
+			fprintf(stderr, "Unknown option \"%s\".\n", argv[i]);
+			return 1;
+		}
+		i++;
+	}
+
+	// Print exact dealer odds for a full shoe, then time a cold query against a cached one
+	if (dealer)
+	{
+		Composition full = Composition::Full(decks);
+		DealerOdds odds;
+		printf("Upcard   17       18       19       20       21       Bust\n");
+		for (int upcard = 1; upcard <= 10; upcard++)
+		{
+			Composition composition = full;
+			composition.Remove(upcard);
+			DealerOutcome outcome = odds.GetOutcome(upcard, composition);
+			printf("%-8s", upcard == 1 ? "A" : upcard == 10 ? "10" : CardGlyphs[upcard - 1]);
+			for (int i = 0; i < 6; i++)
+			{
+				printf(" %-8.4f", outcome.totals[i]);
+			}
+			printf("\n");
+		}
+
+		// Hard 16 against a 10, the whole decision tree
+		Composition composition = full;
+		composition.Remove(10);
+		composition.Remove(10);
+		composition.Remove(6);
+		double times[2];
+		double stand, hit;
+		odds.Clear();
+		for (int i = 0; i < 2; i++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			stand = odds.GetStandEV(16, 10, composition);
+			hit = odds.GetHitEV(16, false, 10, composition);
+			times[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+		}
+		printf("16 vs 10: stand %+.4f, hit %+.4f\n", stand, hit);
+		printf("Cold:     %.1f us\n", times[0]);
+		printf("Cached:   %.1f us\n", times[1]);
+		printf("Hit rate: %.2f%% of %lld lookups\n", 100.0 * odds.GetHits() / std::max(1ll, odds.GetLookups()), odds.GetLookups());
+		return 0;
+	}
+
+	// Play a recorded log again, checking every round deals and settles the same
+	if (replayPath != nullptr)
+	{
+		HistoryReader reader(replayPath);
+		if (!reader.IsOpen())
+		{
+			fprintf(stderr, "Could not read a hand history from \"%s\".\n", replayPath);
+			return 1;
+		}
+		const HistoryHeader& header = reader.GetHeader();
+		ReplayResult result = ReplayHistory(reader);
+		char net[32];
+
+		printf("Seed:        %llu (stream %llu)\n", (unsigned long long)header.seed, (unsigned long long)header.stream);
+		printf("Decks:       %d\n", header.decks);
+		printf("Rounds:      %lld (%lld settled)\n", result.rounds, result.settled);
+		printf("Net:         %s\n", FormatMoney(result.net.cents, net));
+		printf("Mismatches:  %lld", result.mismatches);
+		if (result.firstMismatch >= 0)
+		{
+			printf(" (first in round %lld)", result.firstMismatch);
+		}
+		printf("\n");
+		if (reader.IsCorrupt())
+		{
+			printf("Log is corrupt after round %lld.\n", result.rounds);
+		}
+		printf("Time:        %.3f s (%.0f rounds/s)\n", result.seconds, result.GetRoundsPerSecond());
+		return result.mismatches == 0 && !reader.IsCorrupt() ? 0 : 1;
+	}
+
+	// Pick a strategy
+	Strategy strategy;
+	if (strcmp(strategyName, "stand") == 0)
+	{
+		strategy = StandStrategy;
+	}
+	else if (strcmp(strategyName, "dealer") == 0)
+	{
+		strategy = MimicDealerStrategy;
+	}
+	else if (strcmp(strategyName, "safe") == 0)
+	{
+		strategy = NeverBustStrategy;
+	}
+	else if (strcmp(strategyName, "basic") == 0)
+	{
+		strategy = BasicStrategy;
+	}
+	else
+	{
+		fprintf(stderr, "Unknown strategy \"%s\", expected stand, dealer, safe or basic.\n", strategyName);
+		return 1;
+	}
+
+	// Compare the batch kernels against the game, lane n against a simulator on stream n
+	if (batch)
+	{
+		int hitMax;
+		if (!BatchSimulator::GetHitMax(strategy, hitMax))
+		{
+			fprintf(stderr, "The batch kernel cannot play \"%s\".\n", strategyName);
+			return 1;
+		}
+
+		Xoshiro256 streams[BatchLanes];
+		for (int i = 0; i < BatchLanes; i++)
+		{
+			streams[i] = Xoshiro256::Stream(seed, i);
+		}
+		long long laneRounds = rounds / BatchLanes;
+
+		SimulationResult game;
+		for (int i = 0; i < BatchLanes; i++)
+		{
+			Simulator simulator(strategy, 1000, 10, 0, decks);
+			*simulator.GetGame()->GetRandom() = streams[i];
+			simulator.GetGame()->PopulateDeck();
+			SimulationResult lane = simulator.Run(laneRounds);
+			game.rounds += lane.rounds;
+			game.wins += lane.wins;
+			game.losses += lane.losses;
+			game.pushes += lane.pushes;
+			game.net += lane.net;
+			game.seconds += lane.seconds;
+		}
+		SimulationResult scalar = BatchSimulator(hitMax, decks, streams).Run(laneRounds, false);
+		SimulationResult vector = BatchSimulator(hitMax, decks, streams).Run(laneRounds, true);
+
+		printf("Kernel   Hands/s        Wins        Losses      Pushes      Net\n");
+		const SimulationResult* results[] = { &game, &scalar, &vector };
+		const char* names[] = { "Game", "Scalar", BatchSimulator::IsVectorized() ? "AVX2" : "Scalar" };
+		bool identical = true;
+		char net[32];
+		for (int i = 0; i < 3; i++)
+		{
+			const SimulationResult& result = *results[i];
+			printf("%-8s %-14.0f %-11lld %-11lld %-11lld %s\n", names[i], result.GetHandsPerSecond(),
+				result.wins, result.losses, result.pushes, FormatMoney(result.net, net));
+			identical = identical && result.wins == game.wins && result.losses == game.losses
+				&& result.pushes == game.pushes && result.net == game.net;
+		}
+		printf("Identical: %s\n", identical ? "yes" : "NO");
+		return identical ? 0 : 1;
+	}
+
+	// Measure hands/s from 1 thread up to all of them, checking every run agrees
+	if (scaling)
+	{
+		int maxThreads = threads > 0 ? threads : (int)std::max(1u, std::thread::hardware_concurrency());
+		SimulationResult baseline;
+		printf("Threads  Hands/s        Speedup  Identical\n");
+		for (int count = 1; count <= maxThreads; count = count < maxThreads && count * 2 > maxThreads ? maxThreads : count * 2)
+		{
+			ParallelRunner runner(strategy, count, decks, seed, pin);
+			SimulationResult result = runner.Run(rounds);
+			if (count == 1)
+			{
+				baseline = result;
+			}
+			bool identical = result.net == baseline.net && result.wins == baseline.wins
+				&& result.losses == baseline.losses && result.pushes == baseline.pushes
+				&& result.bankroll == baseline.bankroll;
+			printf("%-8d %-14.0f %-8.2f %s\n", count, result.GetHandsPerSecond(),
+				result.GetHandsPerSecond() / baseline.GetHandsPerSecond(), identical ? "yes" : "NO");
+			if (!identical)
+			{
+				return 1;
+			}
+		}
+		return 0;
+	}
+
+	// Record every round to a hand history, played on one thread from the seed itself
+	if (recordPath != nullptr)
+	{
+		Simulator simulator(strategy, 1000, 10, 1024, decks, seed);
+		HistoryWriter history(recordPath, HistoryHeader::Describe(simulator.GetGame()->GetRules(), 0.75f, seed));
+		if (!history.IsOpen())
+		{
+			fprintf(stderr, "Could not open \"%s\" for writing.\n", recordPath);
+			return 1;
+		}
+		simulator.GetGame()->SetHistory(&history);
+		SimulationResult result = simulator.Run(rounds);
+		simulator.GetGame()->SetHistory(nullptr);
+		history.Flush();
+		char net[32];
+
+		printf("Strategy:    %s\n", strategyName);
+		printf("Decks:       %d\n", decks);
+		printf("Seed:        %llu\n", (unsigned long long)seed);
+		printf("Rounds:      %lld\n", result.rounds);
+		printf("Net:         %s\n", FormatMoney(result.net, net));
+		printf("Recorded:    %lld rounds to \"%s\"\n", history.GetRounds(), recordPath);
+		printf("Time:        %.3f s (%.0f hands/s)\n", result.seconds, result.GetHandsPerSecond());
+		return 0;
+	}
+
+	// Play a full table, every seat with the same strategy, on one thread
+	if (seats > 0)
+	{
+		TableSimulator simulator(strategy, seats, 1000, 10, decks, seed);
+		Ledger ledger(1, audit);
+		simulator.SetLedger(&ledger, 0);
+		SimulationResult result = simulator.Run(rounds);
+		char first[32], second[32];
+
+		printf("Strategy:    %s\n", strategyName);
+		printf("Decks:       %d\n", decks);
+		printf("Seed:        %llu\n", (unsigned long long)seed);
+		printf("Seats:       %d\n", simulator.GetGame()->GetSeats());
+		printf("Hands:       %lld\n", result.rounds);
+		printf("Win:         %.4f%%\n", 100.0 * result.wins / result.rounds);
+		printf("Lose:        %.4f%%\n", 100.0 * result.losses / result.rounds);
+		printf("Push:        %.4f%%\n", 100.0 * result.pushes / result.rounds);
+		printf("EV/hand:     %+.4f (%+.4f%% of wagered)\n", result.GetEV(), 100.0 * result.GetEVPerUnit());
+		printf("Net:         %s\n", FormatMoney(result.net, first));
+		printf("Ledger:      %s settled, %s rebought, %llu transactions\n", FormatMoney(ledger.GetSettled().cents, first),
+			FormatMoney(ledger.GetRebought().cents, second), (unsigned long long)ledger.GetTransactions());
+		// Every cent the seats' balances moved must be in the ledger, as a settlement or a rebuy.
+		bool balanced = (ledger.GetSettled() + ledger.GetRebought()).cents == result.closing - result.opening && ledger.Audit();
+		printf("Balanced:    %s\n", balanced ? "yes" : "NO");
+		printf("Time:        %.3f s (%.0f hands/s)\n", result.seconds, result.GetHandsPerSecond());
+		return balanced ? 0 : 1;
+	}
+
+	ParallelRunner runner(strategy, threads, decks, seed, pin, 1 << 16, 1024, audit);
+	SimulationResult result = runner.Run(rounds);
+	Ledger* ledger = runner.GetLedger();
+	char first[32], second[32];
+
+	printf("Strategy:    %s\n", strategyName);
+	printf("Decks:       %d\n", decks);
+	printf("Seed:        %llu\n", (unsigned long long)seed);
+	printf("Threads:     %d\n", runner.GetThreadCount());
+	printf("Rounds:      %lld\n", result.rounds);
+	printf("Win:         %.4f%%\n", 100.0 * result.wins / result.rounds);
+	printf("Lose:        %.4f%%\n", 100.0 * result.losses / result.rounds);
+	printf("Push:        %.4f%%\n", 100.0 * result.pushes / result.rounds);
+	printf("EV/hand:     %+.4f (%+.4f%% of bet)\n", result.GetEV(), 100.0 * result.GetEVPerUnit());
+	printf("Bankroll:    %s -> %s\n", FormatMoney(result.bankroll.front(), first), FormatMoney(result.bankroll.back(), second));
+	printf("Ledger:      %s settled, %s rebought, %llu transactions\n", FormatMoney(ledger->GetSettled().cents, first),
+		FormatMoney(ledger->GetRebought().cents, second), (unsigned long long)ledger->GetTransactions());
+	// Every cent the players' balances moved must be in the ledger, as a settlement or a rebuy.
+	bool balanced = (ledger->GetSettled() + ledger->GetRebought()).cents == result.closing - result.opening && ledger->Audit();
+	printf("Balanced:    %s\n", balanced ? "yes" : "NO");
+	printf("Time:        %.3f s (%.0f hands/s)\n", result.seconds, result.GetHandsPerSecond());
+
+	// Write the bankroll trajectory
+	if (trajectoryPath != nullptr)
+	{
+		FILE* file = fopen(trajectoryPath, "w");
+		if (file == nullptr)
+		{
+			fprintf(stderr, "Could not open \"%s\" for writing.\n", trajectoryPath);
+			return 1;
+		}
+		fprintf(file, "sample,bankroll\n");
+		for (size_t i = 0; i < result.bankroll.size(); i++)
+		{
+			fprintf(file, "%zu,%s\n", i, FormatMoney(result.bankroll[i], first));
+		}
+		fclose(file);
+	}
+
+	return balanced ? 0 : 1;
+}
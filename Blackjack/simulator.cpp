@@ -0,0 +1,397 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "simulator.hpp"
+#include "strategy.hpp"
+#include <algorithm>
+#include <chrono>
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Always stands.
+/// </summary>
+Action KiwifruitDev::Blackjack::StandStrategy(Card, Hand*)
+{
+	return STAND;
+}
+
+/// <summary>
+/// Hits until 17 or higher, the same as the dealer.
+/// </summary>
+Action KiwifruitDev::Blackjack::MimicDealerStrategy(Card, Hand* hand)
+{
+	return hand->GetScore() <= 16 ? HIT : STAND;
+}
+
+/// <summary>
+/// Hits only when the next card cannot bust the hand.
+/// </summary>
+Action KiwifruitDev::Blackjack::NeverBustStrategy(Card, Hand* hand)
+{
+	return hand->GetScore() <= 11 ? HIT : STAND;
+}
+
+/// <summary>
+/// Looks the hand up in the generated basic strategy tables.
+/// <para>Two cards may double, split or surrender, any more only hit or stand.</para>
+/// </summary>
+Action KiwifruitDev::Blackjack::BasicStrategy(Card upcard, Hand* hand)
+{
+	if (hand->GetCount() != 2)
+	{
+		return BasicStrategyTable[hand->IsSoft()][hand->GetScore()][upcard.GetPoints() - 1];
+	}
+	int first = hand->GetCard(0).GetPoints();
+	if (first == hand->GetCard(1).GetPoints())
+	{
+		return BasicPairTable[first - 1][upcard.GetPoints() - 1];
+	}
+	return BasicOpeningTable[hand->IsSoft()][hand->GetScore()][upcard.GetPoints() - 1];
+}
+
+/// <summary>
+/// Hits or stands by basic strategy, never doubling, splitting or surrendering.
+/// <para>What a strategy falls back to when the game does not allow its action.</para>
+/// </summary>
+Action KiwifruitDev::Blackjack::BasicHitStandStrategy(Card upcard, Hand* hand)
+{
+	return BasicStrategyTable[hand->IsSoft()][hand->GetScore()][upcard.GetPoints() - 1];
+}
+
+/// <summary>
+/// Gets the expected value of a single hand, in units of money.
+/// </summary>
+double SimulationResult::GetEV() const
+{
+	return rounds > 0 ? (double)net / 100.0 / rounds : 0.0;
+}
+
+/// <summary>
+/// Gets the expected value of a single hand, as a fraction of the amount wagered.
+/// </summary>
+double SimulationResult::GetEVPerUnit() const
+{
+	return wagered > 0 ? (double)net / wagered : 0.0;
+}
+
+/// <summary>
+/// Gets the number of hands played per second.
+/// </summary>
+double SimulationResult::GetHandsPerSecond() const
+{
+	return seconds > 0.0 ? rounds / seconds : 0.0;
+}
+
+/// <summary>
+/// Constructor.
+/// </summary>
+/// <param name="strategy">The player's decision function.</param>
+/// <param name="balance">The player's starting balance, in units.</param>
+/// <param name="bet">The amount bet on every round, in units.</param>
+/// <param name="sampleInterval">How many rounds between bankroll samples.</param>
+/// <param name="decks">The number of decks in the shoe.</param>
+/// <param name="seed">The seed, the same seed plays the same rounds.</param>
+Simulator::Simulator(Strategy strategy, int balance, int bet, long long sampleInterval, int decks, uint64_t seed)
+	: game(StandardRules(decks), 0.75f, seed), strategy(strategy), balance(Money::FromUnits(balance)), bet(Money::FromUnits(bet)),
+	sampleInterval(sampleInterval), ledger(), shard(), account()
+{
+	game.GetPlayer()->SetBalance(this->balance);
+	game.GetPlayer()->SetBet(this->bet);
+}
+
+/// <summary>
+/// Constructor continuing an existing random stream.
+/// </summary>
+/// <param name="strategy">The player's decision function.</param>
+/// <param name="balance">The player's starting balance, in units.</param>
+/// <param name="bet">The amount bet on every round, in units.</param>
+/// <param name="sampleInterval">How many rounds between bankroll samples.</param>
+/// <param name="decks">The number of decks in the shoe.</param>
+/// <param name="random">The random number generator's state.</param>
+Simulator::Simulator(Strategy strategy, int balance, int bet, long long sampleInterval, int decks, const Xoshiro256& random)
+	: game(StandardRules(decks), 0.75f, random), strategy(strategy), balance(Money::FromUnits(balance)), bet(Money::FromUnits(bet)),
+	sampleInterval(sampleInterval), ledger(), shard(), account()
+{
+	game.GetPlayer()->SetBalance(this->balance);
+	game.GetPlayer()->SetBet(this->bet);
+}
+
+/// <summary>
+/// Plays a single round.
+/// <para>The player rebuys to the starting balance if they cannot cover the bet.</para>
+/// </summary>
+/// <returns>The amount won (negative if lost) by the player.</returns>
+Money Simulator::PlayRound()
+{
+	// Rebuy if the player can no longer cover the bet.
+	if (game.GetPlayer()->GetBalance() < bet)
+	{
+		if (ledger != nullptr)
+		{
+			Record(TransactionRebuy, balance - game.GetPlayer()->GetBalance());
+		}
+		game.GetPlayer()->SetBalance(balance);
+	}
+	game.GetPlayer()->SetBet(bet);
+	Money before = game.GetPlayer()->GetBalance();
+
+	game.Start();
+
+	// Deal in the same order as the window does.
+	// Two cards for the house, two for the player.
+	game.Deal(false);
+	game.Deal(false);
+	game.DealPlayer();
+	game.DealPlayer();
+
+	// Let the strategy decide until the round is over.
+	// Doubling, splitting or surrendering hits or stands by basic strategy instead when the game does not allow it.
+	while (game.GetState() == GameState::Active)
+	{
+		Card upcard = game.GetHand()->GetCard(0);
+		Hand* hand = game.GetPlayer()->GetHand();
+		if (!game.Apply(strategy(upcard, hand)))
+		{
+			game.Apply(BasicHitStandStrategy(upcard, hand));
+		}
+	}
+
+	Money net = game.GetPlayer()->GetBalance() - before;
+	if (ledger != nullptr)
+	{
+		Record(TransactionSettle, net);
+	}
+	return net;
+}
+
+/// <summary>
+/// Adds a transaction to the batch, committing the batch to the ledger when it is full.
+/// </summary>
+/// <param name="kind">Why the money moved.</param>
+/// <param name="amount">The amount, positive when the player received money.</param>
+void Simulator::Record(TransactionKind kind, Money amount)
+{
+	if (batch.IsFull())
+	{
+		ledger->Commit(shard, batch);
+	}
+	batch.Add(account, kind, amount);
+}
+
+/// <summary>
+/// Records every round and rebuy in a ledger, batched and committed to one shard.
+/// </summary>
+/// <param name="ledger">The ledger, or nullptr to stop recording.</param>
+/// <param name="shard">The shard, only this thread may commit to it.</param>
+/// <param name="account">The account transactions are recorded under.</param>
+void Simulator::SetLedger(Ledger* ledger, int shard, uint32_t account)
+{
+	if (this->ledger != nullptr && batch.GetCount() > 0)
+	{
+		this->ledger->Commit(this->shard, batch);
+	}
+	this->ledger = ledger;
+	this->shard = shard;
+	this->account = account;
+}
+
+/// <summary>
+/// Get the game being played.
+/// </summary>
+/// <returns>The game.</returns>
+Game* Simulator::GetGame()
+{
+	return &game;
+}
+
+/// <summary>
+/// Plays a number of rounds and collects the results.
+/// </summary>
+/// <param name="rounds">The number of rounds to play.</param>
+/// <returns>The results.</returns>
+SimulationResult Simulator::Run(long long rounds)
+{
+	SimulationResult result;
+	result.bankroll.reserve(sampleInterval > 0 ? rounds / sampleInterval + 2 : 1);
+	result.bankroll.push_back(balance.cents);
+	result.opening = game.GetPlayer()->GetBalance().cents;
+
+	auto start = std::chrono::steady_clock::now();
+	for (long long i = 0; i < rounds; i++)
+	{
+		Money net = PlayRound();
+		switch (game.GetState())
+		{
+		case Win:
+			result.wins++;
+			break;
+		case Push:
+			result.pushes++;
+			break;
+		default:
+			result.losses++;
+			break;
+		}
+		result.rounds++;
+		result.wagered += game.GetPlayer()->GetTotalBet().cents;
+		result.net += net.cents;
+
+		// Sample the bankroll.
+		if (sampleInterval > 0 && result.rounds % sampleInterval == 0)
+		{
+			result.bankroll.push_back(balance.cents + result.net);
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	// Sample the rounds after the last full interval, so the trajectory ends on the final bankroll.
+	if (sampleInterval > 0 && result.rounds % sampleInterval != 0)
+	{
+		result.bankroll.push_back(balance.cents + result.net);
+	}
+
+	// Commit what is left, so the ledger is complete once the run returns.
+	if (ledger != nullptr && batch.GetCount() > 0)
+	{
+		ledger->Commit(shard, batch);
+	}
+	result.closing = game.GetPlayer()->GetBalance().cents;
+	result.seconds = std::chrono::duration<double>(end - start).count();
+
+	return result;
+}
+
+/// <summary>
+/// Constructor, starts the worker threads.
+/// </summary>
+/// <param name="strategy">The player's decision function.</param>
+/// <param name="threads">The number of worker threads, 0 for one per hardware thread.</param>
+/// <param name="decks">The number of decks in each shoe.</param>
+/// <param name="seed">The seed all streams derive from.</param>
+/// <param name="pin">Pin each worker thread to its own CPU.</param>
+/// <param name="chunkRounds">The number of rounds in a chunk.</param>
+/// <param name="sampleInterval">How many rounds between bankroll samples, must divide chunkRounds.</param>
+/// <param name="keepLog">Keep every transaction in the ledger, not only the totals.</param>
+ParallelRunner::ParallelRunner(Strategy strategy, int threads, int decks, uint64_t seed, bool pin, long long chunkRounds, long long sampleInterval, bool keepLog)
+	: pool(threads, pin), ledger(pool.GetThreadCount(), keepLog), strategy(strategy), decks(decks), seed(seed), chunkRounds(chunkRounds), sampleInterval(sampleInterval) {}
+
+/// <summary>
+/// Plays a number of rounds and collects the results.
+/// </summary>
+/// <param name="rounds">The number of rounds to play.</param>
+/// <returns>The results.</returns>
+SimulationResult ParallelRunner::Run(long long rounds)
+{
+	uint32_t chunks = (uint32_t)((rounds + chunkRounds - 1) / chunkRounds);
+
+	// Chunk n plays on stream n, jumping once per chunk here is far cheaper than n times per chunk.
+	std::vector<Xoshiro256> streams;
+	streams.reserve(chunks);
+	Xoshiro256 stream(seed);
+	for (uint32_t i = 0; i < chunks; i++)
+	{
+		streams.push_back(stream);
+		stream.Jump();
+	}
+
+	std::vector<Accumulator> accumulators(pool.GetThreadCount(), Accumulator());
+
+	// Each chunk writes only its own slot, so the trajectory can be stitched together in order afterwards.
+	std::vector<std::vector<long long>> samples(chunks);
+
+	auto start = std::chrono::steady_clock::now();
+	pool.ForEach(chunks, [&](uint32_t chunk, int worker)
+	{
+		long long count = std::min(chunkRounds, rounds - chunk * chunkRounds);
+
+		Simulator simulator(strategy, 1000, 10, sampleInterval, decks, streams[chunk]);
+		simulator.SetLedger(&ledger, worker, chunk);
+		SimulationResult result = simulator.Run(count);
+
+		Accumulator& accumulator = accumulators[worker];
+		accumulator.rounds += result.rounds;
+		accumulator.wins += result.wins;
+		accumulator.losses += result.losses;
+		accumulator.pushes += result.pushes;
+		accumulator.wagered += result.wagered;
+		accumulator.net += result.net;
+		accumulator.opening += result.opening;
+		accumulator.closing += result.closing;
+		samples[chunk].swap(result.bankroll);
+	});
+	auto end = std::chrono::steady_clock::now();
+
+	// Merge the workers' totals.
+	SimulationResult result;
+	for (const Accumulator& accumulator : accumulators)
+	{
+		result.rounds += accumulator.rounds;
+		result.wins += accumulator.wins;
+		result.losses += accumulator.losses;
+		result.pushes += accumulator.pushes;
+		result.wagered += accumulator.wagered;
+		result.net += accumulator.net;
+		result.opening += accumulator.opening;
+		result.closing += accumulator.closing;
+	}
+	result.seconds = std::chrono::duration<double>(end - start).count();
+
+	// Stitch the trajectory, each chunk continues from where the previous one ended.
+	long long balance = Money::FromUnits(1000).cents;
+	result.bankroll.push_back(balance);
+	for (const std::vector<long long>& chunk : samples)
+	{
+		for (size_t i = 1; i < chunk.size(); i++)
+		{
+			result.bankroll.push_back(balance + chunk[i] - chunk[0]);
+		}
+		if (!chunk.empty())
+		{
+			balance += chunk.back() - chunk[0];
+		}
+	}
+
+	return result;
+}
+
+/// <summary>
+/// Gets the number of worker threads.
+/// </summary>
+/// <returns>The number of worker threads.</returns>
+int ParallelRunner::GetThreadCount()
+{
+	return pool.GetThreadCount();
+}
+
+/// <summary>
+/// Gets the ledger every run is recorded in.
+/// </summary>
+/// <returns>The ledger.</returns>
+Ledger* ParallelRunner::GetLedger()
+{
+	return &ledger;
+}
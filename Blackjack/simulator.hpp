@@ -0,0 +1,337 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "game.hpp"
+#include "ledger.hpp"
+#include "pool.hpp"
+#include <vector>
+
+// Headless simulation, no raylib required
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// A player decision function.
+		/// </summary>
+		/// <param name="upcard">The dealer's visible card.</param>
+		/// <param name="hand">The player's hand.</param>
+		/// <returns>The action to take.</returns>
+		typedef Action (*Strategy)(Card upcard, Hand* hand);
+
+		/// <summary>
+		/// Always stands.
+		/// </summary>
+		Action StandStrategy(Card upcard, Hand* hand);
+
+		/// <summary>
+		/// Hits until 17 or higher, the same as the dealer.
+		/// </summary>
+		Action MimicDealerStrategy(Card upcard, Hand* hand);
+
+		/// <summary>
+		/// Hits only when the next card cannot bust the hand.
+		/// </summary>
+		Action NeverBustStrategy(Card upcard, Hand* hand);
+
+		/// <summary>
+		/// Looks the hand up in the generated basic strategy tables.
+		/// <para>Two cards may double, split or surrender, any more only hit or stand.</para>
+		/// </summary>
+		Action BasicStrategy(Card upcard, Hand* hand);
+
+		/// <summary>
+		/// Hits or stands by basic strategy, never doubling, splitting or surrendering.
+		/// <para>What a strategy falls back to when the game does not allow its action.</para>
+		/// </summary>
+		Action BasicHitStandStrategy(Card upcard, Hand* hand);
+
+		/// <summary>
+		/// Results of a simulation run.
+		/// </summary>
+		struct SimulationResult
+		{
+			/// <summary>
+			/// Number of rounds played.
+			/// </summary>
+			long long rounds = 0;
+
+			/// <summary>
+			/// Rounds won by the player.
+			/// </summary>
+			long long wins = 0;
+
+			/// <summary>
+			/// Rounds won by the dealer.
+			/// </summary>
+			long long losses = 0;
+
+			/// <summary>
+			/// Rounds tied.
+			/// </summary>
+			long long pushes = 0;
+
+			/// <summary>
+			/// Total amount wagered, in cents.
+			/// </summary>
+			long long wagered = 0;
+
+			/// <summary>
+			/// Net amount won (negative if lost) by the player, in cents.
+			/// </summary>
+			long long net = 0;
+
+			/// <summary>
+			/// The players' balances when the run started and when it ended, in cents, summed over every player.
+			/// <para>Read from the players themselves, so a ledger can be checked against what was actually paid.</para>
+			/// </summary>
+			long long opening = 0;
+			long long closing = 0;
+
+			/// <summary>
+			/// Bankroll in cents, sampled at a fixed round interval, starting with the initial balance and ending with the final one.
+			/// <para>Rebuys are not counted, so this is the bankroll of a player with unlimited credit.</para>
+			/// </summary>
+			std::vector<long long> bankroll;
+
+			/// <summary>
+			/// Wall-clock time spent playing, in seconds.
+			/// </summary>
+			double seconds = 0.0;
+
+			/// <summary>
+			/// Gets the expected value of a single hand, in units of money.
+			/// </summary>
+			double GetEV() const;
+
+			/// <summary>
+			/// Gets the expected value of a single hand, as a fraction of the amount wagered.
+			/// </summary>
+			double GetEVPerUnit() const;
+
+			/// <summary>
+			/// Gets the number of hands played per second.
+			/// </summary>
+			double GetHandsPerSecond() const;
+		};
+
+		/// <summary>
+		/// Plays rounds of <see cref="Game"/> without a window, driven by a strategy.
+		/// </summary>
+		class Simulator
+		{
+		private:
+			/// <summary>
+			/// The game being played.
+			/// </summary>
+			Game game;
+
+			/// <summary>
+			/// The player's decision function.
+			/// </summary>
+			Strategy strategy;
+
+			/// <summary>
+			/// The balance the player starts with, and rebuys to when broke.
+			/// </summary>
+			Money balance;
+
+			/// <summary>
+			/// The amount bet on every round.
+			/// </summary>
+			Money bet;
+
+			/// <summary>
+			/// How many rounds between bankroll samples.
+			/// </summary>
+			long long sampleInterval;
+
+			/// <summary>
+			/// The ledger rounds are recorded in, if any, and where in it.
+			/// </summary>
+			Ledger* ledger;
+			int shard;
+			uint32_t account;
+
+			/// <summary>
+			/// Transactions waiting to be committed to the ledger.
+			/// </summary>
+			LedgerBatch batch;
+
+			/// <summary>
+			/// Adds a transaction to the batch, committing the batch to the ledger when it is full.
+			/// </summary>
+			/// <param name="kind">Why the money moved.</param>
+			/// <param name="amount">The amount, positive when the player received money.</param>
+			void Record(TransactionKind kind, Money amount);
+		public:
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			/// <param name="strategy">The player's decision function.</param>
+			/// <param name="balance">The player's starting balance, in units.</param>
+			/// <param name="bet">The amount bet on every round, in units.</param>
+			/// <param name="sampleInterval">How many rounds between bankroll samples.</param>
+			/// <param name="decks">The number of decks in the shoe.</param>
+			/// <param name="seed">The seed, the same seed plays the same rounds.</param>
+			Simulator(Strategy strategy, int balance = 1000, int bet = 10, long long sampleInterval = 1000, int decks = 6, uint64_t seed = 0);
+
+			/// <summary>
+			/// Constructor continuing an existing random stream.
+			/// </summary>
+			/// <param name="strategy">The player's decision function.</param>
+			/// <param name="balance">The player's starting balance, in units.</param>
+			/// <param name="bet">The amount bet on every round, in units.</param>
+			/// <param name="sampleInterval">How many rounds between bankroll samples.</param>
+			/// <param name="decks">The number of decks in the shoe.</param>
+			/// <param name="random">The random number generator's state.</param>
+			Simulator(Strategy strategy, int balance, int bet, long long sampleInterval, int decks, const Xoshiro256& random);
+
+			/// <summary>
+			/// Plays a single round.
+			/// <para>The player rebuys to the starting balance if they cannot cover the bet.</para>
+			/// </summary>
+			/// <returns>The amount won (negative if lost) by the player.</returns>
+			Money PlayRound();
+
+			/// <summary>
+			/// Records every round and rebuy in a ledger, batched and committed to one shard.
+			/// </summary>
+			/// <param name="ledger">The ledger, or nullptr to stop recording.</param>
+			/// <param name="shard">The shard, only this thread may commit to it.</param>
+			/// <param name="account">The account transactions are recorded under.</param>
+			void SetLedger(Ledger* ledger, int shard, uint32_t account);
+
+			/// <summary>
+			/// Get the game being played.
+			/// </summary>
+			/// <returns>The game.</returns>
+			Game* GetGame();
+
+			/// <summary>
+			/// Plays a number of rounds and collects the results.
+			/// </summary>
+			/// <param name="rounds">The number of rounds to play.</param>
+			/// <returns>The results.</returns>
+			SimulationResult Run(long long rounds);
+		};
+
+		/// <summary>
+		/// Plays rounds on every core.
+		/// <para>Rounds are split into fixed size chunks, each played by a fresh <see cref="Simulator"/> on its own random stream.</para>
+		/// <para>Chunks do not depend on which worker plays them, so a seed gives the same results at any thread count.</para>
+		/// </summary>
+		class ParallelRunner
+		{
+		private:
+			/// <summary>
+			/// Totals kept by each worker, merged once all chunks are done.
+			/// <para>Padded to a cache line so workers never share one.</para>
+			/// </summary>
+			struct alignas(64) Accumulator
+			{
+				long long rounds;
+				long long wins;
+				long long losses;
+				long long pushes;
+				long long wagered;
+				long long net;
+				long long opening;
+				long long closing;
+			};
+
+			/// <summary>
+			/// The worker threads.
+			/// </summary>
+			WorkStealingPool pool;
+
+			/// <summary>
+			/// Every round and rebuy, one shard per worker.
+			/// </summary>
+			Ledger ledger;
+
+			/// <summary>
+			/// The player's decision function.
+			/// </summary>
+			Strategy strategy;
+
+			/// <summary>
+			/// The number of decks in each shoe.
+			/// </summary>
+			int decks;
+
+			/// <summary>
+			/// The seed all streams derive from.
+			/// </summary>
+			uint64_t seed;
+
+			/// <summary>
+			/// The number of rounds in a chunk.
+			/// </summary>
+			long long chunkRounds;
+
+			/// <summary>
+			/// How many rounds between bankroll samples, must divide <see cref="ParallelRunner::chunkRounds"/>.
+			/// </summary>
+			long long sampleInterval;
+		public:
+			/// <summary>
+			/// Constructor, starts the worker threads.
+			/// </summary>
+			/// <param name="strategy">The player's decision function.</param>
+			/// <param name="threads">The number of worker threads, 0 for one per hardware thread.</param>
+			/// <param name="decks">The number of decks in each shoe.</param>
+			/// <param name="seed">The seed all streams derive from.</param>
+			/// <param name="pin">Pin each worker thread to its own CPU.</param>
+			/// <param name="chunkRounds">The number of rounds in a chunk.</param>
+			/// <param name="sampleInterval">How many rounds between bankroll samples, must divide chunkRounds.</param>
+			/// <param name="keepLog">Keep every transaction in the ledger, not only the totals.</param>
+			ParallelRunner(Strategy strategy, int threads = 0, int decks = 6, uint64_t seed = 0, bool pin = false, long long chunkRounds = 1 << 16, long long sampleInterval = 1024, bool keepLog = false);
+
+			/// <summary>
+			/// Plays a number of rounds and collects the results.
+			/// </summary>
+			/// <param name="rounds">The number of rounds to play.</param>
+			/// <returns>The results.</returns>
+			SimulationResult Run(long long rounds);
+
+			/// <summary>
+			/// Gets the number of worker threads.
+			/// </summary>
+			/// <returns>The number of worker threads.</returns>
+			int GetThreadCount();
+
+			/// <summary>
+			/// Gets the ledger every run is recorded in.
+			/// </summary>
+			/// <returns>The ledger.</returns>
+			Ledger* GetLedger();
+		};
+	}
+}
@@ -0,0 +1,139 @@
+// Generated by StrategyGen --decks 6, do not edit.
+
+#pragma once
+
+#include "simulator.hpp"
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// Hit or stand for 6 decks on any hand, indexed by [soft][total][upcard points - 1].
+		/// <para>What basic strategy falls back to once a hand cannot double, split or surrender.</para>
+		/// </summary>
+		constexpr Action BasicStrategyTable[2][22][10] =
+		{
+			{
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, STAND, STAND, STAND, HIT, HIT, HIT, HIT },
+				{ HIT, STAND, STAND, STAND, STAND, STAND, HIT, HIT, HIT, HIT },
+				{ HIT, STAND, STAND, STAND, STAND, STAND, HIT, HIT, HIT, HIT },
+				{ HIT, STAND, STAND, STAND, STAND, STAND, HIT, HIT, HIT, HIT },
+				{ HIT, STAND, STAND, STAND, STAND, STAND, HIT, HIT, HIT, HIT },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+			},
+			{
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, STAND, STAND, STAND, STAND, STAND, STAND, STAND, HIT, HIT },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+			},
+		};
+
+		/// <summary>
+		/// The first decision for 6 decks on two cards that are not a pair, indexed by [soft][total][upcard points - 1].
+		/// </summary>
+		constexpr Action BasicOpeningTable[2][22][10] =
+		{
+			{
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, DOUBLE, DOUBLE, DOUBLE, DOUBLE, HIT, HIT, HIT, HIT },
+				{ HIT, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, HIT },
+				{ HIT, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, HIT },
+				{ HIT, HIT, HIT, STAND, STAND, STAND, HIT, HIT, HIT, HIT },
+				{ HIT, STAND, STAND, STAND, STAND, STAND, HIT, HIT, HIT, HIT },
+				{ HIT, STAND, STAND, STAND, STAND, STAND, HIT, HIT, HIT, HIT },
+				{ HIT, STAND, STAND, STAND, STAND, STAND, HIT, HIT, HIT, HIT },
+				{ HIT, STAND, STAND, STAND, STAND, STAND, HIT, HIT, SURRENDER, SURRENDER },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+			},
+			{
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT }, // Unused
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, HIT, DOUBLE, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, DOUBLE, DOUBLE, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, HIT, DOUBLE, DOUBLE, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, DOUBLE, DOUBLE, DOUBLE, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, HIT, DOUBLE, DOUBLE, DOUBLE, HIT, HIT, HIT, HIT },
+				{ HIT, HIT, DOUBLE, DOUBLE, DOUBLE, DOUBLE, HIT, HIT, HIT, HIT },
+				{ HIT, STAND, DOUBLE, DOUBLE, DOUBLE, DOUBLE, STAND, STAND, HIT, HIT },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+				{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+			},
+		};
+
+		/// <summary>
+		/// The first decision for 6 decks on a pair, indexed by [pair points - 1][upcard points - 1].
+		/// </summary>
+		constexpr Action BasicPairTable[10][10] =
+		{
+			{ HIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT },
+			{ HIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, HIT, HIT, HIT },
+			{ HIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, HIT, HIT, HIT },
+			{ HIT, HIT, HIT, HIT, SPLIT, SPLIT, HIT, HIT, HIT, HIT },
+			{ HIT, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, DOUBLE, HIT },
+			{ HIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, HIT, HIT, HIT, HIT },
+			{ HIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, HIT, HIT, HIT },
+			{ HIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, SURRENDER },
+			{ STAND, SPLIT, SPLIT, SPLIT, SPLIT, SPLIT, STAND, SPLIT, SPLIT, STAND },
+			{ STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND, STAND },
+		};
+	}
+}
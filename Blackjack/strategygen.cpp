@@ -0,0 +1,490 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "dealer.hpp"
+#include "simulator.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace KiwifruitDev::Blackjack;
+
+// Basic strategy generator
+// Derives every basic strategy decision from exact dealer odds and writes them as strategy.hpp:
+// hit or stand on any hand, hit, stand, double or surrender on two cards, and when to split a pair.
+// The tables follow StandardRules with the game's dealer, who does not peek for blackjack.
+// Usage: StrategyGen [--decks n] [--output strategy.hpp] [--check]
+//
+// --check generates the tables again for a dealer who peeks, as published charts assume,
+// and compares them against the published chart for 4 to 8 decks, S17, double after split and late surrender.
+
+// Reference charts
+// Columns are the upcards 2 to 10 followed by the ace, rows start at the total in the first column.
+// H hit, S stand, D double or else hit, d double or else stand, R surrender or else hit, P split.
+static const char* HardReference[] =
+{
+	" 5 HHHHHHHHHH",
+	" 6 HHHHHHHHHH",
+	" 7 HHHHHHHHHH",
+	" 8 HHHHHHHHHH",
+	" 9 HDDDDHHHHH",
+	"10 DDDDDDDDHH",
+	"11 DDDDDDDDDH",
+	"12 HHSSSHHHHH",
+	"13 SSSSSHHHHH",
+	"14 SSSSSHHHHH",
+	"15 SSSSSHHHRH",
+	"16 SSSSSHHRRR",
+	"17 SSSSSSSSSS",
+	"18 SSSSSSSSSS",
+	"19 SSSSSSSSSS",
+	"20 SSSSSSSSSS",
+};
+
+static const char* SoftReference[] =
+{
+	"13 HHHDDHHHHH",
+	"14 HHHDDHHHHH",
+	"15 HHDDDHHHHH",
+	"16 HHDDDHHHHH",
+	"17 HDDDDHHHHH",
+	"18 SddddSSHHH",
+	"19 SSSSSSSSSS",
+	"20 SSSSSSSSSS",
+};
+
+// Pair rows start at the points of either card, 1 for aces.
+static const char* PairReference[] =
+{
+	" 1 PPPPPPPPPP",
+	" 2 PPPPPPHHHH",
+	" 3 PPPPPPHHHH",
+	" 4 HHHPPHHHHH",
+	" 5 DDDDDDDDHH",
+	" 6 PPPPPHHHHH",
+	" 7 PPPPPPHHHH",
+	" 8 PPPPPPPPPP",
+	" 9 PPPPPSPPSS",
+	"10 SSSSSSSSSS",
+};
+
+/// <summary>
+/// The names the header uses for each action.
+/// </summary>
+static const char* ActionNames[ActionCount] = { "HIT", "STAND", "DOUBLE", "SPLIT", "SURRENDER" };
+
+/// <summary>
+/// Every table basic strategy is made of.
+/// </summary>
+struct StrategyTables
+{
+	/// <summary>
+	/// Hit or stand on any hand, by [soft][total][upcard points - 1].
+	/// </summary>
+	Action hitStand[2][22][10];
+
+	/// <summary>
+	/// The first decision on two cards that are not a pair, by [soft][total][upcard points - 1].
+	/// </summary>
+	Action opening[2][22][10];
+
+	/// <summary>
+	/// The first decision on a pair, by [pair points - 1][upcard points - 1].
+	/// </summary>
+	Action pairs[10][10];
+};
+
+/// <summary>
+/// Gets a hand's score from its hard score, counting an ace as 11 if that does not bust.
+/// </summary>
+static int Score(int hard, bool ace)
+{
+	return hard + (ace && hard <= 11 ? 10 : 0);
+}
+
+/// <summary>
+/// Gets the expected value of doubling, drawing one card for twice the bet.
+/// </summary>
+/// <param name="composition">The cards left, restored before returning.</param>
+static double GetDoubleEV(DealerOdds& odds, int hard, bool ace, int upcard, Composition& composition)
+{
+	double ev = 0.0;
+	int total = composition.total;
+	for (int points = 1; points <= 10; points++)
+	{
+		int count = composition.counts[points - 1];
+		if (count == 0)
+		{
+			continue;
+		}
+		composition.Remove(points);
+		ev += (double)count / total * odds.GetStandEV(Score(hard + points, ace || points == 1), upcard, composition);
+		composition.Add(points);
+	}
+	return 2.0 * ev;
+}
+
+/// <summary>
+/// Gets the expected value of surrendering half the bet.
+/// <para>Without a peek, a dealer blackjack still takes the whole bet.</para>
+/// </summary>
+static double GetSurrenderEV(DealerOdds& odds, int upcard, const Composition& composition)
+{
+	if (odds.GetPeek() || (upcard != 1 && upcard != 10))
+	{
+		return -0.5;
+	}
+	double natural = (double)composition.counts[upcard == 1 ? 9 : 0] / composition.total;
+	return -0.5 - 0.5 * natural;
+}
+
+/// <summary>
+/// Gets the expected value of splitting a pair into two hands.
+/// <para>Each hand draws its second card from the same cards and is played on optimally, split aces stand on it.
+/// Resplitting is left out, it is worth too little to change a decision.</para>
+/// </summary>
+/// <param name="composition">The cards left once the upcard and both cards of the pair are dealt, restored before returning.</param>
+static double GetSplitEV(DealerOdds& odds, int pair, int upcard, Composition& composition)
+{
+	double ev = 0.0;
+	int total = composition.total;
+	for (int points = 1; points <= 10; points++)
+	{
+		int count = composition.counts[points - 1];
+		if (count == 0)
+		{
+			continue;
+		}
+		composition.Remove(points);
+		int hard = pair + points;
+		bool ace = pair == 1 || points == 1;
+		double hand = odds.GetStandEV(Score(hard, ace), upcard, composition);
+		if (pair != 1)
+		{
+			double hit = odds.GetHitEV(hard, ace, upcard, composition);
+			hand = hit > hand ? hit : hand;
+			if (StandardRules::doubleAfterSplit)
+			{
+				double doubled = GetDoubleEV(odds, hard, ace, upcard, composition);
+				hand = doubled > hand ? doubled : hand;
+			}
+		}
+		ev += (double)count / total * hand;
+		composition.Add(points);
+	}
+	return 2.0 * ev;
+}
+
+/// <summary>
+/// Adds the expected value of every action on a two card hand, weighted by the chance of being dealt it.
+/// </summary>
+/// <param name="odds">The dealer odds.</param>
+/// <param name="full">The shoe before any card is dealt.</param>
+/// <param name="first">The player's first card points, 1 for aces.</param>
+/// <param name="second">The player's second card points, 1 for aces.</param>
+/// <param name="upcard">The dealer's upcard points, 1 for aces.</param>
+/// <param name="ev">The weighted expected value of each action, splitting only for a pair.</param>
+static void AddHand(DealerOdds& odds, const Composition& full, int first, int second, int upcard, double (&ev)[ActionCount])
+{
+	Composition composition = full;
+	composition.Remove(upcard);
+	double chance = (double)composition.counts[first - 1] / composition.total;
+	composition.Remove(first);
+	chance *= (double)composition.counts[second - 1] / composition.total * (first == second ? 1 : 2);
+	composition.Remove(second);
+	int hard = first + second;
+	bool ace = first == 1 || second == 1;
+	ev[HIT] += chance * odds.GetHitEV(hard, ace, upcard, composition);
+	ev[STAND] += chance * odds.GetStandEV(Score(hard, ace), upcard, composition);
+	ev[DOUBLE] += chance * GetDoubleEV(odds, hard, ace, upcard, composition);
+	ev[SURRENDER] += chance * GetSurrenderEV(odds, upcard, composition);
+	if (first == second)
+	{
+		ev[SPLIT] += chance * GetSplitEV(odds, first, upcard, composition);
+	}
+}
+
+/// <summary>
+/// Picks the action with the highest expected value out of a set, standing on a tie.
+/// </summary>
+static Action Best(const double (&ev)[ActionCount], ActionSet actions)
+{
+	Action best = STAND;
+	for (int i = 0; i < ActionCount; i++)
+	{
+		if ((actions & ActionBit((Action)i)) != 0 && ev[i] > ev[best])
+		{
+			best = (Action)i;
+		}
+	}
+	return best;
+}
+
+/// <summary>
+/// Generates every table, hard hands only reach 20 with two cards so 21 always stands.
+/// </summary>
+/// <param name="odds">The dealer odds, peeking or not.</param>
+/// <param name="full">The shoe before any card is dealt.</param>
+/// <param name="tables">The tables.</param>
+static void Generate(DealerOdds& odds, const Composition& full, StrategyTables& tables)
+{
+	const ActionSet hitStand = ActionBit(HIT) | ActionBit(STAND);
+	const ActionSet opening = hitStand | ActionBit(DOUBLE) | (StandardRules::lateSurrender ? ActionBit(SURRENDER) : 0);
+	const ActionSet pair = opening | (StandardRules::maxHands > 1 ? ActionBit(SPLIT) : 0);
+
+	for (int upcard = 1; upcard <= 10; upcard++)
+	{
+		for (int total = 0; total < 22; total++)
+		{
+			for (int soft = 0; soft < 2; soft++)
+			{
+				tables.hitStand[soft][total][upcard - 1] = total < 21 ? HIT : STAND;
+				tables.opening[soft][total][upcard - 1] = total < 21 ? HIT : STAND;
+			}
+		}
+
+		// Hard totals, over every two cards that make them
+		for (int total = 4; total <= 20; total++)
+		{
+			double ev[ActionCount] = {};
+			for (int first = 2; first <= 10 && first * 2 <= total; first++)
+			{
+				int second = total - first;
+				if (second <= 10)
+				{
+					AddHand(odds, full, first, second, upcard, ev);
+				}
+			}
+			tables.hitStand[0][total][upcard - 1] = Best(ev, hitStand);
+			tables.opening[0][total][upcard - 1] = Best(ev, opening);
+		}
+
+		// Soft totals, an ace and one other card
+		for (int total = 12; total <= 20; total++)
+		{
+			double ev[ActionCount] = {};
+			AddHand(odds, full, 1, total == 12 ? 1 : total - 11, upcard, ev);
+			tables.hitStand[1][total][upcard - 1] = Best(ev, hitStand);
+			tables.opening[1][total][upcard - 1] = Best(ev, opening);
+		}
+
+		// Pairs
+		for (int points = 1; points <= 10; points++)
+		{
+			double ev[ActionCount] = {};
+			AddHand(odds, full, points, points, upcard, ev);
+			tables.pairs[points - 1][upcard - 1] = Best(ev, pair);
+		}
+	}
+}
+
+/// <summary>
+/// Gets a decision's code in the reference charts.
+/// </summary>
+/// <param name="action">The decision.</param>
+/// <param name="fallback">Hit or stand, for when the decision is not allowed.</param>
+static char GetCode(Action action, Action fallback)
+{
+	switch (action)
+	{
+	case HIT:
+		return 'H';
+	case STAND:
+		return 'S';
+	case DOUBLE:
+		return fallback == HIT ? 'D' : 'd';
+	case SPLIT:
+		return 'P';
+	default:
+		return fallback == HIT ? 'R' : 'r';
+	}
+}
+
+/// <summary>
+/// Compares generated tables against a reference chart.
+/// </summary>
+/// <param name="soft">0 for hard totals, 1 for soft totals, 2 for pairs.</param>
+/// <returns>The number of cells that differ.</returns>
+static int Check(const StrategyTables& tables, const char** reference, int rows, int kind, const char* name)
+{
+	int errors = 0;
+	for (int row = 0; row < rows; row++)
+	{
+		int total = atoi(reference[row]);
+		for (int column = 0; column < 10; column++)
+		{
+			// Columns run 2 to 10 then the ace, the tables run ace to 10
+			int upcard = column == 9 ? 1 : column + 2;
+			char generated;
+			if (kind == 2)
+			{
+				// Pairs fall back on their total, aces on soft 12
+				Action fallback = tables.hitStand[total == 1][total == 1 ? 12 : total * 2][upcard - 1];
+				generated = GetCode(tables.pairs[total - 1][upcard - 1], fallback);
+			}
+			else
+			{
+				generated = GetCode(tables.opening[kind][total][upcard - 1], tables.hitStand[kind][total][upcard - 1]);
+			}
+			char expected = reference[row][3 + column];
+			if (generated != expected)
+			{
+				fprintf(stderr, "%s %d against %d: generated %c, reference %c.\n", name, total, upcard, generated, expected);
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+/// <summary>
+/// Writes one row of a table.
+/// </summary>
+static void WriteRow(FILE* file, const Action (&row)[10], int tabs, const char* comment)
+{
+	fprintf(file, "%.*s{ ", tabs, "\t\t\t\t");
+	for (int upcard = 0; upcard < 10; upcard++)
+	{
+		fprintf(file, "%s%s", ActionNames[row[upcard]], upcard < 9 ? ", " : "");
+	}
+	fprintf(file, " },%s\n", comment);
+}
+
+/// <summary>
+/// Writes a table by total as a constexpr array initializer.
+/// </summary>
+static void WriteTable(FILE* file, const Action (&table)[22][10])
+{
+	fprintf(file, "\t\t\t{\n");
+	for (int total = 0; total < 22; total++)
+	{
+		WriteRow(file, table[total], 4, total >= 4 ? "" : " // Unused");
+	}
+	fprintf(file, "\t\t\t},\n");
+}
+
+int main(int argc, char** argv)
+{
+	int decks = 6;
+	const char* outputPath = nullptr;
+	bool check = false;
+
+	// Parse options
+	for (int i = 1; i < argc; i++)
+	{
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		if (strcmp(argv[i], "--check") == 0)
+		{
+			check = true;
+			continue;
+		}
+		else if (value == nullptr)
+		{
+			fprintf(stderr, "Missing value for \"%s\".\n", argv[i]);
+			return 1;
+		}
+		else if (strcmp(argv[i], "--decks") == 0)
+		{
+			decks = atoi(value);
+		}
+		else if (strcmp(argv[i], "--output") == 0)
+		{
+			outputPath = value;
+		}
+		else
+		{
+			fprintf(stderr, "Unknown option \"%s\".\n", argv[i]);
+			return 1;
+		}
+		i++;
+	}
+
+	Composition full = Composition::Full(decks);
+
+	// Compare against the reference chart, which assumes the dealer peeks
+	if (check)
+	{
+		DealerOdds peeking(1 << 22, true);
+		StrategyTables tables;
+		Generate(peeking, full, tables);
+		int errors = Check(tables, HardReference, sizeof(HardReference) / sizeof(*HardReference), 0, "Hard")
+			+ Check(tables, SoftReference, sizeof(SoftReference) / sizeof(*SoftReference), 1, "Soft")
+			+ Check(tables, PairReference, sizeof(PairReference) / sizeof(*PairReference), 2, "Pair");
+		if (errors > 0)
+		{
+			fprintf(stderr, "%d cells differ from the reference chart.\n", errors);
+			return 1;
+		}
+		printf("Basic strategy matches the reference chart.\n");
+	}
+
+	if (outputPath == nullptr)
+	{
+		return 0;
+	}
+
+	// Generate the tables for the game's dealer
+	DealerOdds odds;
+	StrategyTables tables;
+	Generate(odds, full, tables);
+
+	// Write the header
+	FILE* file = fopen(outputPath, "w");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Could not open \"%s\" for writing.\n", outputPath);
+		return 1;
+	}
+	fprintf(file, "// Generated by StrategyGen --decks %d, do not edit.\n\n", decks);
+	fprintf(file, "#pragma once\n\n#include \"simulator.hpp\"\n\n");
+	fprintf(file, "namespace KiwifruitDev\n{\n\tnamespace Blackjack\n\t{\n");
+	fprintf(file, "\t\t/// <summary>\n");
+	fprintf(file, "\t\t/// Hit or stand for %d decks on any hand, indexed by [soft][total][upcard points - 1].\n", decks);
+	fprintf(file, "\t\t/// <para>What basic strategy falls back to once a hand cannot double, split or surrender.</para>\n");
+	fprintf(file, "\t\t/// </summary>\n");
+	fprintf(file, "\t\tconstexpr Action BasicStrategyTable[2][22][10] =\n\t\t{\n");
+	WriteTable(file, tables.hitStand[0]);
+	WriteTable(file, tables.hitStand[1]);
+	fprintf(file, "\t\t};\n\n");
+	fprintf(file, "\t\t/// <summary>\n");
+	fprintf(file, "\t\t/// The first decision for %d decks on two cards that are not a pair, indexed by [soft][total][upcard points - 1].\n", decks);
+	fprintf(file, "\t\t/// </summary>\n");
+	fprintf(file, "\t\tconstexpr Action BasicOpeningTable[2][22][10] =\n\t\t{\n");
+	WriteTable(file, tables.opening[0]);
+	WriteTable(file, tables.opening[1]);
+	fprintf(file, "\t\t};\n\n");
+	fprintf(file, "\t\t/// <summary>\n");
+	fprintf(file, "\t\t/// The first decision for %d decks on a pair, indexed by [pair points - 1][upcard points - 1].\n", decks);
+	fprintf(file, "\t\t/// </summary>\n");
+	fprintf(file, "\t\tconstexpr Action BasicPairTable[10][10] =\n\t\t{\n");
+	for (int points = 0; points < 10; points++)
+	{
+		WriteRow(file, tables.pairs[points], 3, "");
+	}
+	fprintf(file, "\t\t};\n\t}\n}\n");
+	fclose(file);
+	return 0;
+}
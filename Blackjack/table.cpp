@@ -0,0 +1,173 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "table.hpp"
+#include <chrono>
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Constructor.
+/// </summary>
+/// <param name="strategy">The decision function every seat uses.</param>
+/// <param name="seats">The number of occupied seats.</param>
+/// <param name="balance">Each seat's starting balance, in units.</param>
+/// <param name="bet">The amount every seat bets each round, in units.</param>
+/// <param name="decks">The number of decks in the shoe.</param>
+/// <param name="seed">The seed.</param>
+TableSimulator::TableSimulator(Strategy strategy, int seats, int balance, int bet, int decks, uint64_t seed)
+	: game(seats, StandardRules(decks), 0.75f, seed), strategy(strategy), balance(Money::FromUnits(balance)), bet(Money::FromUnits(bet)),
+	ledger(), shard()
+{
+	for (int i = 0; i < game.GetSeats(); i++)
+	{
+		game.GetPlayer(i)->SetBalance(this->balance);
+		game.GetPlayer(i)->SetBet(this->bet);
+	}
+}
+
+/// <summary>
+/// Adds a transaction to the batch, committing the batch to the ledger when it is full.
+/// </summary>
+/// <param name="seat">The seat the money moved for.</param>
+/// <param name="kind">Why the money moved.</param>
+/// <param name="amount">The amount, positive when the seat received money.</param>
+void TableSimulator::Record(int seat, TransactionKind kind, Money amount)
+{
+	if (batch.IsFull())
+	{
+		ledger->Commit(shard, batch);
+	}
+	batch.Add((uint32_t)seat, kind, amount);
+}
+
+/// <summary>
+/// Plays a number of rounds, counting each seat's hand as one round in the results.
+/// <para>The bankroll trajectory only holds the starting and final bankroll of all seats.</para>
+/// </summary>
+/// <param name="rounds">The number of rounds to play.</param>
+/// <returns>The results.</returns>
+SimulationResult TableSimulator::Run(long long rounds)
+{
+	SimulationResult result;
+	const int seats = game.GetSeats();
+	result.bankroll.push_back(balance.cents * seats);
+	for (int i = 0; i < seats; i++)
+	{
+		result.opening += game.GetPlayer(i)->GetBalance().cents;
+	}
+
+	Money before[Game::MaxSeats];
+	auto start = std::chrono::steady_clock::now();
+	for (long long round = 0; round < rounds; round++)
+	{
+		// Rebuy any seat that can no longer cover its bet.
+		for (int i = 0; i < seats; i++)
+		{
+			Player* player = game.GetPlayer(i);
+			if (player->GetBalance() < bet)
+			{
+				if (ledger != nullptr)
+				{
+					Record(i, TransactionRebuy, balance - player->GetBalance());
+				}
+				player->SetBalance(balance);
+			}
+			player->SetBet(bet);
+			before[i] = player->GetBalance();
+		}
+
+		game.Start();
+		game.DealRound();
+
+		// Every seat plays in turn until the round settles.
+		// Doubling, splitting or surrendering hits or stands by basic strategy instead when the game does not allow it.
+		while (game.GetState() == GameState::Active)
+		{
+			Card upcard = game.GetHand()->GetCard(0);
+			Hand* hand = game.GetPlayer()->GetHand();
+			if (!game.Apply(strategy(upcard, hand)))
+			{
+				game.Apply(BasicHitStandStrategy(upcard, hand));
+			}
+		}
+
+		for (int i = 0; i < seats; i++)
+		{
+			Player* player = game.GetPlayer(i);
+			Money net = player->GetBalance() - before[i];
+			result.wins += net > Money();
+			result.losses += net < Money();
+			result.pushes += net == Money();
+			result.wagered += player->GetTotalBet().cents;
+			result.net += net.cents;
+			result.rounds++;
+			if (ledger != nullptr)
+			{
+				Record(i, TransactionSettle, net);
+			}
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+	result.seconds = std::chrono::duration<double>(end - start).count();
+
+	// Commit what is left, so the ledger is complete once the run returns.
+	if (ledger != nullptr && batch.GetCount() > 0)
+	{
+		ledger->Commit(shard, batch);
+	}
+	for (int i = 0; i < seats; i++)
+	{
+		result.closing += game.GetPlayer(i)->GetBalance().cents;
+	}
+
+	result.bankroll.push_back(result.bankroll.front() + result.net);
+	return result;
+}
+
+/// <summary>
+/// Records every round and rebuy in a ledger, batched and committed to one shard.
+/// </summary>
+/// <param name="ledger">The ledger, or nullptr to stop recording.</param>
+/// <param name="shard">The shard, only this thread may commit to it.</param>
+void TableSimulator::SetLedger(Ledger* ledger, int shard)
+{
+	if (this->ledger != nullptr && batch.GetCount() > 0)
+	{
+		this->ledger->Commit(this->shard, batch);
+	}
+	this->ledger = ledger;
+	this->shard = shard;
+}
+
+/// <summary>
+/// Get the game every seat is played in.
+/// </summary>
+/// <returns>The game.</returns>
+Game* TableSimulator::GetGame()
+{
+	return &game;
+}
@@ -0,0 +1,116 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include "simulator.hpp"
+
+// Full tables, several seats against one dealer
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// Plays rounds at a table and collects the results of every seat.
+		/// </summary>
+		class TableSimulator
+		{
+		private:
+			/// <summary>
+			/// The table being played, every seat in one game.
+			/// </summary>
+			Game game;
+
+			/// <summary>
+			/// The decision function every seat uses.
+			/// </summary>
+			Strategy strategy;
+
+			/// <summary>
+			/// Each seat's starting balance, and the balance it rebuys to.
+			/// </summary>
+			Money balance;
+
+			/// <summary>
+			/// The amount every seat bets each round.
+			/// </summary>
+			Money bet;
+
+			/// <summary>
+			/// The ledger rounds are recorded in, if any, and where in it.
+			/// <para>Each seat is its own account.</para>
+			/// </summary>
+			Ledger* ledger;
+			int shard;
+
+			/// <summary>
+			/// Transactions waiting to be committed to the ledger.
+			/// </summary>
+			LedgerBatch batch;
+
+			/// <summary>
+			/// Adds a transaction to the batch, committing the batch to the ledger when it is full.
+			/// </summary>
+			/// <param name="seat">The seat the money moved for.</param>
+			/// <param name="kind">Why the money moved.</param>
+			/// <param name="amount">The amount, positive when the seat received money.</param>
+			void Record(int seat, TransactionKind kind, Money amount);
+		public:
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			/// <param name="strategy">The decision function every seat uses.</param>
+			/// <param name="seats">The number of occupied seats.</param>
+			/// <param name="balance">Each seat's starting balance, in units.</param>
+			/// <param name="bet">The amount every seat bets each round, in units.</param>
+			/// <param name="decks">The number of decks in the shoe.</param>
+			/// <param name="seed">The seed.</param>
+			TableSimulator(Strategy strategy, int seats, int balance = 1000, int bet = 10, int decks = 6, uint64_t seed = 0);
+
+			/// <summary>
+			/// Plays a number of rounds, counting each seat's hand as one round in the results.
+			/// <para>The bankroll trajectory only holds the starting and final bankroll of all seats.</para>
+			/// </summary>
+			/// <param name="rounds">The number of rounds to play.</param>
+			/// <returns>The results.</returns>
+			SimulationResult Run(long long rounds);
+
+			/// <summary>
+			/// Records every round and rebuy in a ledger, batched and committed to one shard.
+			/// </summary>
+			/// <param name="ledger">The ledger, or nullptr to stop recording.</param>
+			/// <param name="shard">The shard, only this thread may commit to it.</param>
+			void SetLedger(Ledger* ledger, int shard);
+
+			/// <summary>
+			/// Get the game every seat is played in.
+			/// </summary>
+			/// <returns>The game.</returns>
+			Game* GetGame();
+		};
+	}
+}
@@ -0,0 +1,163 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#include "timeline.hpp"
+#include <algorithm>
+
+using namespace KiwifruitDev::Blackjack;
+
+/// <summary>
+/// Gets how far the tween has got, eased out.
+/// </summary>
+/// <param name="now">The time.</param>
+/// <returns>0 before the tween starts, 1 once it is done.</returns>
+float Tween::GetProgress(double now) const
+{
+	if (now <= start)
+	{
+		return 0.0f;
+	}
+	if (now >= start + duration)
+	{
+		return 1.0f;
+	}
+	// Quadratic ease out, quick to leave and gentle to land.
+	float t = (float)((now - start) / duration);
+	return t * (2.0f - t);
+}
+
+/// <summary>
+/// Gets the tween's value.
+/// </summary>
+/// <param name="now">The time.</param>
+/// <returns>The value.</returns>
+float Tween::GetValue(double now) const
+{
+	return from + (to - from) * GetProgress(now);
+}
+
+/// <summary>
+/// Constructor.
+/// </summary>
+Timeline::Timeline() : now(0.0), order(0) {}
+
+/// <summary>
+/// Destructor, destroys every waiting coroutine.
+/// </summary>
+Timeline::~Timeline()
+{
+	Clear();
+}
+
+/// <summary>
+/// Orders the heap so the earliest sleeper is on top.
+/// </summary>
+/// <param name="a">A sleeper.</param>
+/// <param name="b">Another sleeper.</param>
+/// <returns>True if a is due after b.</returns>
+bool Timeline::Later(const Sleeper& a, const Sleeper& b)
+{
+	return a.time != b.time ? a.time > b.time : a.order > b.order;
+}
+
+/// <summary>
+/// Parks a coroutine until a time.
+/// </summary>
+/// <param name="handle">The coroutine.</param>
+/// <param name="time">The time to resume it.</param>
+void Timeline::Schedule(std::coroutine_handle<> handle, double time)
+{
+	sleepers.push_back(Sleeper{ time, order++, handle });
+	std::push_heap(sleepers.begin(), sleepers.end(), Later);
+}
+
+/// <summary>
+/// Gets an awaitable that resumes at a time.
+/// </summary>
+/// <param name="time">The time.</param>
+/// <returns>The awaitable.</returns>
+Timeline::Wait Timeline::At(double time)
+{
+	return Wait{ this, time };
+}
+
+/// <summary>
+/// Gets an awaitable that resumes after a delay from now.
+/// </summary>
+/// <param name="seconds">The delay.</param>
+/// <returns>The awaitable.</returns>
+Timeline::Wait Timeline::After(double seconds)
+{
+	return Wait{ this, now + seconds };
+}
+
+/// <summary>
+/// Moves the time on, resuming every coroutine that is due in the order they are due.
+/// </summary>
+/// <param name="time">The new time, never earlier than the last.</param>
+void Timeline::Advance(double time)
+{
+	// A resumed step sees the time it was due at, so steps chained by After keep their spacing.
+	while (!sleepers.empty() && sleepers.front().time <= time)
+	{
+		std::pop_heap(sleepers.begin(), sleepers.end(), Later);
+		Sleeper due = sleepers.back();
+		sleepers.pop_back();
+		now = std::max(now, due.time);
+		due.handle.resume();
+	}
+	now = std::max(now, time);
+}
+
+/// <summary>
+/// Destroys every waiting coroutine without resuming it.
+/// </summary>
+void Timeline::Clear()
+{
+	for (Sleeper& sleeper : sleepers)
+	{
+		sleeper.handle.destroy();
+	}
+	sleepers.clear();
+}
+
+/// <summary>
+/// Gets the time as of the last <see cref="Timeline::Advance"/>.
+/// </summary>
+/// <returns>The time.</returns>
+double Timeline::GetTime() const
+{
+	return now;
+}
+
+/// <summary>
+/// Checks if any coroutine is waiting.
+/// </summary>
+/// <returns>True if nothing is waiting.</returns>
+bool Timeline::IsIdle() const
+{
+	return sleepers.empty();
+}
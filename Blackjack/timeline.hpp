@@ -0,0 +1,201 @@
+/*
+	raylib-stuff: Blackjack
+
+	MIT License
+
+	Copyright (c) 2023 KiwifruitDev
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+// Animation steps written as coroutines, resumed by a timeline once per frame
+
+namespace KiwifruitDev
+{
+	namespace Blackjack
+	{
+		/// <summary>
+		/// A value eased from one number to another over a span of time.
+		/// <para>Tweens are not stepped, they are worked out from the time when read, so idle ones cost nothing.</para>
+		/// </summary>
+		struct Tween
+		{
+			/// <summary>
+			/// When the tween starts and how long it takes, in seconds.
+			/// </summary>
+			double start;
+			double duration;
+
+			/// <summary>
+			/// The values before and after.
+			/// </summary>
+			float from;
+			float to;
+
+			/// <summary>
+			/// Gets how far the tween has got, eased out.
+			/// </summary>
+			/// <param name="now">The time.</param>
+			/// <returns>0 before the tween starts, 1 once it is done.</returns>
+			float GetProgress(double now) const;
+
+			/// <summary>
+			/// Gets the tween's value.
+			/// </summary>
+			/// <param name="now">The time.</param>
+			/// <returns>The value.</returns>
+			float GetValue(double now) const;
+		};
+
+		/// <summary>
+		/// Resumes coroutines at the times they wait for.
+		/// <para>Waiting steps are kept in a heap by time, so advancing a frame only touches the steps that are due.</para>
+		/// </summary>
+		class Timeline
+		{
+		public:
+			/// <summary>
+			/// A coroutine run by the timeline, it starts at once and frees itself when it returns.
+			/// <para>Nothing holds a task to report an exception to, so one escaping a task ends the program.</para>
+			/// </summary>
+			struct Task
+			{
+				struct promise_type
+				{
+					Task get_return_object() noexcept { return Task(); }
+					std::suspend_never initial_suspend() noexcept { return {}; }
+					std::suspend_never final_suspend() noexcept { return {}; }
+					void return_void() noexcept {}
+					void unhandled_exception() noexcept { std::terminate(); }
+				};
+			};
+
+			/// <summary>
+			/// Awaited to wait until a time, a time already passed does not wait.
+			/// </summary>
+			struct Wait
+			{
+				Timeline* timeline;
+				double time;
+
+				bool await_ready() const noexcept { return time <= timeline->now; }
+				void await_suspend(std::coroutine_handle<> handle) { timeline->Schedule(handle, time); }
+				void await_resume() const noexcept {}
+			};
+		private:
+			/// <summary>
+			/// A waiting coroutine.
+			/// <para>The order breaks ties so steps due together resume in the order they began waiting.</para>
+			/// </summary>
+			struct Sleeper
+			{
+				double time;
+				uint64_t order;
+				std::coroutine_handle<> handle;
+			};
+
+			/// <summary>
+			/// Waiting coroutines, a heap with the earliest first.
+			/// </summary>
+			std::vector<Sleeper> sleepers;
+
+			/// <summary>
+			/// The time as of the last <see cref="Timeline::Advance"/>.
+			/// </summary>
+			double now;
+
+			/// <summary>
+			/// Counts calls to <see cref="Timeline::Schedule"/>.
+			/// </summary>
+			uint64_t order;
+
+			/// <summary>
+			/// Orders the heap so the earliest sleeper is on top.
+			/// </summary>
+			/// <param name="a">A sleeper.</param>
+			/// <param name="b">Another sleeper.</param>
+			/// <returns>True if a is due after b.</returns>
+			static bool Later(const Sleeper& a, const Sleeper& b);
+
+			/// <summary>
+			/// Parks a coroutine until a time.
+			/// </summary>
+			/// <param name="handle">The coroutine.</param>
+			/// <param name="time">The time to resume it.</param>
+			void Schedule(std::coroutine_handle<> handle, double time);
+		public:
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			Timeline();
+
+			/// <summary>
+			/// Destructor, destroys every waiting coroutine.
+			/// </summary>
+			~Timeline();
+
+			Timeline(const Timeline&) = delete;
+			Timeline& operator=(const Timeline&) = delete;
+
+			/// <summary>
+			/// Gets an awaitable that resumes at a time.
+			/// </summary>
+			/// <param name="time">The time.</param>
+			/// <returns>The awaitable.</returns>
+			Wait At(double time);
+
+			/// <summary>
+			/// Gets an awaitable that resumes after a delay from now.
+			/// </summary>
+			/// <param name="seconds">The delay.</param>
+			/// <returns>The awaitable.</returns>
+			Wait After(double seconds);
+
+			/// <summary>
+			/// Moves the time on, resuming every coroutine that is due in the order they are due.
+			/// </summary>
+			/// <param name="time">The new time, never earlier than the last.</param>
+			void Advance(double time);
+
+			/// <summary>
+			/// Destroys every waiting coroutine without resuming it.
+			/// </summary>
+			void Clear();
+
+			/// <summary>
+			/// Gets the time as of the last <see cref="Timeline::Advance"/>.
+			/// </summary>
+			/// <returns>The time.</returns>
+			double GetTime() const;
+
+			/// <summary>
+			/// Checks if any coroutine is waiting.
+			/// </summary>
+			/// <returns>True if nothing is waiting.</returns>
+			bool IsIdle() const;
+		};
+	}
+}